@@ -170,6 +170,14 @@ char *mutt_idna_intl_to_local(const char *user, const char *domain, int flags)
   }
 #endif /* HAVE_LIBIDN */
 
+  /* ASCII reads the same in any charset, so it needs no (reversible) conversion */
+  if (mutt_str_is_ascii(user, mutt_str_strlen(user)) &&
+      mutt_str_is_ascii(domain, mutt_str_strlen(domain)) &&
+      (mutt_str_strcmp(local_domain, domain) == 0))
+  {
+    goto done;
+  }
+
   /* we don't want charset-hook effects, so we set flags to 0 */
   if (mutt_ch_convert_string(&local_user, "utf-8", C_Charset, 0) != 0)
     goto cleanup;
@@ -235,6 +243,7 @@ char *mutt_idna_intl_to_local(const char *user, const char *domain, int flags)
     }
   }
 
+done:
   mailbox = mutt_mem_malloc(mutt_str_strlen(local_user) + mutt_str_strlen(local_domain) + 2);
   sprintf(mailbox, "%s@%s", NONULL(local_user), NONULL(local_domain));
 
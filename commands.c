@@ -161,6 +161,7 @@ static void process_protected_headers(struct Email *e)
       e->env->real_subj = e->env->subject + pmatch[0].rm_eo;
     else
       e->env->real_subj = e->env->subject;
+    FREE(&e->pattern_memo);
 
     if (Context->mailbox->subj_hash)
       mutt_hash_insert(Context->mailbox->subj_hash, e->env->real_subj, e);
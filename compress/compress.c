@@ -826,6 +826,40 @@ static int comp_msg_save_hcache(struct Mailbox *m, struct Email *e)
   return ops->msg_save_hcache(m, e);
 }
 
+/**
+ * comp_hcache_begin - Start a batch of header cache saves - Implements MxOps::hcache_begin()
+ */
+static int comp_hcache_begin(struct Mailbox *m)
+{
+  if (!m || !m->compress_info)
+    return 0;
+
+  struct CompressInfo *ci = m->compress_info;
+
+  const struct MxOps *ops = ci->child_ops;
+  if (!ops || !ops->hcache_begin)
+    return 0;
+
+  return ops->hcache_begin(m);
+}
+
+/**
+ * comp_hcache_commit - Finish a batch of header cache saves - Implements MxOps::hcache_commit()
+ */
+static int comp_hcache_commit(struct Mailbox *m)
+{
+  if (!m || !m->compress_info)
+    return 0;
+
+  struct CompressInfo *ci = m->compress_info;
+
+  const struct MxOps *ops = ci->child_ops;
+  if (!ops || !ops->hcache_commit)
+    return 0;
+
+  return ops->hcache_commit(m);
+}
+
 /**
  * comp_tags_edit - Prompt and validate new messages tags - Implements MxOps::tags_edit()
  */
@@ -951,6 +985,8 @@ struct MxOps MxCompOps = {
   .msg_close        = comp_msg_close,
   .msg_padding_size = comp_msg_padding_size,
   .msg_save_hcache  = comp_msg_save_hcache,
+  .hcache_begin     = comp_hcache_begin,
+  .hcache_commit    = comp_hcache_commit,
   .tags_edit        = comp_tags_edit,
   .tags_commit      = comp_tags_commit,
   .path_probe       = comp_path_probe,
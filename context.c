@@ -96,6 +96,22 @@ static void ctx_cleanup(struct Context *ctx)
   ctx->mailbox = m;
 }
 
+/**
+ * hash_insert_once - Add an Email to a Hash Table, unless it's already there
+ * @param hash Hash Table
+ * @param key  Key, e.g. the Email's Message-ID
+ * @param e    Email
+ */
+static void hash_insert_once(struct Hash *hash, const char *key, struct Email *e)
+{
+  for (struct HashElem *he = mutt_hash_find_bucket(hash, key); he; he = he->next)
+  {
+    if (he->data == e)
+      return;
+  }
+  mutt_hash_insert(hash, key, e);
+}
+
 /**
  * ctx_update - Update the Context's message counts
  * @param ctx          Mailbox
@@ -109,9 +125,6 @@ void ctx_update(struct Context *ctx)
 
   struct Mailbox *m = ctx->mailbox;
 
-  mutt_hash_free(&m->subj_hash);
-  mutt_hash_free(&m->id_hash);
-
   /* reset counters */
   m->msg_unread = 0;
   m->msg_flagged = 0;
@@ -121,7 +134,14 @@ void ctx_update(struct Context *ctx)
   m->vcount = 0;
   m->changed = false;
 
-  mutt_clear_threads(ctx);
+  /* If mail has only been added, thread it into the existing tree */
+  const bool rethread = !mutt_threads_valid(ctx);
+  if (rethread)
+  {
+    mutt_hash_free(&m->subj_hash);
+    mutt_hash_free(&m->id_hash);
+    mutt_clear_threads(ctx);
+  }
 
   struct Email *e = NULL;
   for (int msgno = 0; msgno < m->msg_count; msgno++)
@@ -130,7 +150,8 @@ void ctx_update(struct Context *ctx)
     if (!e)
       continue;
 
-    if (WithCrypto)
+    /* A threaded Email was already here last time */
+    if (WithCrypto && !e->thread)
     {
       /* NOTE: this _must_ be done before the check for mailcap! */
       e->security = crypt_query(e->content);
@@ -163,11 +184,14 @@ void ctx_update(struct Context *ctx)
       }
     }
 
-    /* add this message to the hash tables */
-    if (m->id_hash && e->env->message_id)
-      mutt_hash_insert(m->id_hash, e->env->message_id, e);
-    if (m->subj_hash && e->env->real_subj)
-      mutt_hash_insert(m->subj_hash, e->env->real_subj, e);
+    /* add this message to the hash tables, unless it's already threaded */
+    if (!e->thread)
+    {
+      if (m->id_hash && e->env->message_id)
+        hash_insert_once(m->id_hash, e->env->message_id, e);
+      if (m->subj_hash && e->env->real_subj)
+        hash_insert_once(m->subj_hash, e->env->real_subj, e);
+    }
     mutt_label_hash_add(m, e);
 
     if (C_Score)
@@ -187,7 +211,7 @@ void ctx_update(struct Context *ctx)
     }
   }
 
-  mutt_sort_headers(ctx, true); /* rethread from scratch */
+  mutt_sort_headers(ctx, rethread);
 }
 
 /**
@@ -440,13 +440,15 @@ int mutt_copy_header(FILE *fp_in, struct Email *e, FILE *fp_out,
 
   if ((chflags & CH_UPDATE) && ((chflags & CH_NOSTATUS) == 0))
   {
+    const bool pad = (chflags & CH_PAD_STATUS);
+
     if (e->old || e->read)
     {
       fputs("Status: ", fp_out);
       if (e->read)
         fputs("RO", fp_out);
       else if (e->old)
-        fputc('O', fp_out);
+        fputs(pad ? "O " : "O", fp_out);
       fputc('\n', fp_out);
     }
 
@@ -455,8 +457,12 @@ int mutt_copy_header(FILE *fp_in, struct Email *e, FILE *fp_out,
       fputs("X-Status: ", fp_out);
       if (e->replied)
         fputc('A', fp_out);
+      else if (pad)
+        fputc(' ', fp_out);
       if (e->flagged)
         fputc('F', fp_out);
+      else if (pad)
+        fputc(' ', fp_out);
       fputc('\n', fp_out);
     }
   }
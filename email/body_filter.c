@@ -0,0 +1,149 @@
+/**
+ * @file
+ * Trigram filter of the text of an email
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page email_body_filter Trigram filter of the text of an email
+ *
+ * A small summary of the text of an email, which is kept in the header cache.
+ * A search for a string can use it to skip emails that can't contain it,
+ * without reading them.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include "mutt/lib.h"
+#include "body_filter.h"
+
+#define BF_MIN_SIZE 32   ///< Smallest filter, in bytes
+#define BF_MAX_SIZE 4096 ///< Largest filter, in bytes
+
+/**
+ * fold - Fold the case of an ASCII character
+ * @param c Character
+ * @retval num Lower-case character
+ *
+ * Other bytes are left alone, so the result doesn't depend on the locale.
+ */
+static inline unsigned char fold(unsigned char c)
+{
+  return ((c >= 'A') && (c <= 'Z')) ? (c + ('a' - 'A')) : c;
+}
+
+/**
+ * trigram_bits - Find the two bits that represent a trigram
+ * @param[in]  tri  Trigram, packed into an integer
+ * @param[in]  mask Number of bits in the filter, minus one
+ * @param[out] b1   First bit
+ * @param[out] b2   Second bit
+ */
+static inline void trigram_bits(unsigned int tri, unsigned int mask,
+                                unsigned int *b1, unsigned int *b2)
+{
+  unsigned int h1 = tri * 0x9E3779B1U;
+  unsigned int h2 = tri * 0x85EBCA77U;
+  *b1 = (h1 ^ (h1 >> 15)) & mask;
+  *b2 = (h2 ^ (h2 >> 13)) & mask;
+}
+
+/**
+ * body_filter_new - Create a filter of some text
+ * @param text Text, e.g. the body of an email
+ * @param len  Length of the text
+ * @retval ptr New filter
+ *
+ * The filter is sized to the text, at about one bit per character, within
+ * limits.  Trigrams spanning a newline aren't recorded, because searches are
+ * done line by line.
+ */
+struct BodyFilter *body_filter_new(const char *text, size_t len)
+{
+  unsigned int size = BF_MIN_SIZE;
+  while ((size < BF_MAX_SIZE) && ((size * 8) < len))
+    size *= 2;
+
+  struct BodyFilter *bf = mutt_mem_calloc(1, sizeof(struct BodyFilter) + size);
+  bf->size = size;
+
+  const unsigned int mask = (size * 8) - 1;
+  unsigned int tri = 0;
+  unsigned int b1, b2;
+  int count = 0;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    if (text[i] == '\n')
+    {
+      count = 0;
+      continue;
+    }
+
+    tri = ((tri << 8) | fold(text[i])) & 0xffffff;
+    if (++count < 3)
+      continue;
+
+    trigram_bits(tri, mask, &b1, &b2);
+    bf->bits[b1 >> 3] |= (1 << (b1 & 7));
+    bf->bits[b2 >> 3] |= (1 << (b2 & 7));
+  }
+
+  return bf;
+}
+
+/**
+ * body_filter_may_contain - Might some text contain a string?
+ * @param bf  Filter of the text
+ * @param str String to look for
+ * @param len Length of the string
+ * @retval true  The string may be in the text
+ * @retval false The string definitely isn't in the text, ignoring case
+ *
+ * Strings shorter than a trigram always may be present.
+ */
+bool body_filter_may_contain(const struct BodyFilter *bf, const char *str, size_t len)
+{
+  if (!bf || !str || (len < 3))
+    return true;
+
+  const unsigned int mask = (bf->size * 8) - 1;
+  unsigned int tri = 0;
+  unsigned int b1, b2;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    tri = ((tri << 8) | fold(str[i])) & 0xffffff;
+    if (i < 2)
+      continue;
+
+    trigram_bits(tri, mask, &b1, &b2);
+    if (!(bf->bits[b1 >> 3] & (1 << (b1 & 7))) || !(bf->bits[b2 >> 3] & (1 << (b2 & 7))))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * body_filter_free - Free a BodyFilter
+ * @param ptr BodyFilter to free
+ */
+void body_filter_free(struct BodyFilter **ptr)
+{
+  FREE(ptr);
+}
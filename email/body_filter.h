@@ -0,0 +1,42 @@
+/**
+ * @file
+ * Trigram filter of the text of an email
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_EMAIL_BODY_FILTER_H
+#define MUTT_EMAIL_BODY_FILTER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * struct BodyFilter - Which trigrams occur in the text of an email
+ *
+ * This is a Bloom filter of every (case-folded) three-character sequence of the
+ * text.  If any trigram of a string is missing, the string isn't in the text.
+ */
+struct BodyFilter
+{
+  unsigned int size;    ///< Size of the bit array in bytes, a power of two
+  unsigned char bits[]; ///< Bit array
+};
+
+void               body_filter_free       (struct BodyFilter **ptr);
+bool               body_filter_may_contain(const struct BodyFilter *bf, const char *str, size_t len);
+struct BodyFilter *body_filter_new        (const char *text, size_t len);
+
+#endif /* MUTT_EMAIL_BODY_FILTER_H */
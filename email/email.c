@@ -31,6 +31,7 @@
 #include "mutt/lib.h"
 #include "email.h"
 #include "body.h"
+#include "body_filter.h"
 #include "envelope.h"
 #include "tags.h"
 
@@ -51,7 +52,10 @@ void email_free(struct Email **ptr)
   mutt_env_free(&e->env);
   mutt_body_free(&e->content);
   FREE(&e->maildir_flags);
+  body_filter_free(&e->body_filter);
+  FREE(&e->pattern_memo);
   FREE(&e->tree);
+  FREE(&e->index_line);
   FREE(&e->path);
 #ifdef MIXMASTER
   mutt_list_free(&e->chain);
@@ -31,6 +31,9 @@
 #include "ncrypt/lib.h"
 #include "tags.h"
 
+struct BodyFilter;
+struct PatternMemo;
+
 /**
  * struct Email - The envelope/body of an email
  */
@@ -72,6 +75,7 @@ struct Email
   // the following are used to support collapsing threads
   bool collapsed : 1;          ///< Is this message part of a collapsed thread?
   bool limited   : 1;          ///< Is this message in a limited view?
+  bool limit_checked : 1;      ///< Has the limit been applied to this message?
   size_t num_hidden;           ///< Number of hidden messages in this view
 
   short recipient;             ///< User_is_recipient()'s return value, cached
@@ -93,6 +97,11 @@ struct Email
   char *tree;                  ///< Character string to print thread tree
   struct MuttThread *thread;   ///< Thread of Emails
 
+  char *index_line;            ///< Cached line of the index, see index_make_entry()
+  unsigned int index_line_gen; ///< Generation of the index line cache when it was made
+  int index_line_cols;         ///< Width of the cached line of the index
+  int index_line_flags;        ///< Format flags of the cached line of the index
+
   short attach_total;          ///< Number of qualifying attachments in message, if attach_valid
 
 #ifdef MIXMASTER
@@ -103,6 +112,9 @@ struct Email
 
   char *maildir_flags;         ///< Unknown maildir flags
 
+  struct BodyFilter *body_filter; ///< Trigrams of the body, to speed up searches
+  struct PatternMemo *pattern_memo; ///< Remembered results of pattern matches, see mutt_pattern_exec()
+
   void *edata;                    ///< Driver-specific data
   void (*free_edata)(void **ptr); ///< Driver-specific data free function
   struct Notify *notify;          ///< Notifications handler
@@ -25,22 +25,23 @@
  *
  * Structs that make up an email
  *
- * | File                   | Description              |
- * | :--------------------- | :----------------------- |
- * | email/attach.c         | @subpage email_attach    |
- * | email/body.c           | @subpage email_body      |
- * | email/email_globals.c  | @subpage email_globals   |
- * | email/envelope.c       | @subpage email_envelope  |
- * | email/from.c           | @subpage email_from      |
- * | email/email.c          | @subpage email_email     |
- * | email/mime.c           | @subpage email_mime      |
- * | email/parameter.c      | @subpage email_parameter |
- * | email/parse.c          | @subpage email_parse     |
- * | email/rfc2047.c        | @subpage email_rfc2047   |
- * | email/rfc2231.c        | @subpage email_rfc2231   |
- * | email/tags.c           | @subpage email_tags      |
- * | email/thread.c         | @subpage email_thread    |
- * | email/url.c            | @subpage email_url       |
+ * | File                   | Description                |
+ * | :--------------------- | :------------------------- |
+ * | email/attach.c         | @subpage email_attach      |
+ * | email/body.c           | @subpage email_body        |
+ * | email/body_filter.c    | @subpage email_body_filter |
+ * | email/email_globals.c  | @subpage email_globals     |
+ * | email/envelope.c       | @subpage email_envelope    |
+ * | email/from.c           | @subpage email_from        |
+ * | email/email.c          | @subpage email_email       |
+ * | email/mime.c           | @subpage email_mime        |
+ * | email/parameter.c      | @subpage email_parameter   |
+ * | email/parse.c          | @subpage email_parse       |
+ * | email/rfc2047.c        | @subpage email_rfc2047     |
+ * | email/rfc2231.c        | @subpage email_rfc2231     |
+ * | email/tags.c           | @subpage email_tags        |
+ * | email/thread.c         | @subpage email_thread      |
+ * | email/url.c            | @subpage email_url         |
  */
 
 #ifndef MUTT_EMAIL_LIB_H
@@ -49,6 +50,7 @@
 // IWYU pragma: begin_exports
 #include "attach.h"
 #include "body.h"
+#include "body_filter.h"
 #include "content.h"
 #include "email.h"
 #include "email_globals.h"
@@ -139,6 +139,10 @@ static size_t q_encoder(char *str, const char *buf, size_t buflen, const char *t
 static char *parse_encoded_word(char *str, enum ContentEncoding *enc, char **charset,
                                 size_t *charsetlen, char **text, size_t *textlen)
 {
+  /* Most strings contain no encoded words: don't bother compiling the regex */
+  if (!strstr(str, "=?"))
+    return NULL;
+
   regmatch_t match[4];
   size_t nmatch = 4;
   struct Regex *re = mutt_regex_compile("=\\?"
@@ -214,6 +214,7 @@ void clean_references(struct MuttThread *brk, struct MuttThread *cur)
 
       e->changed = true;
       e->env->changed |= MUTT_ENV_CHANGED_REFS;
+      FREE(&e->pattern_memo);
     }
   }
 }
@@ -231,6 +232,7 @@ void mutt_break_thread(struct Email *e)
   mutt_list_free(&e->env->references);
   e->changed = true;
   e->env->changed |= (MUTT_ENV_CHANGED_IRT | MUTT_ENV_CHANGED_REFS);
+  FREE(&e->pattern_memo);
 
   clean_references(e->thread, e->thread->child);
 }
@@ -309,6 +309,7 @@ static void color_line_free(struct Colors *c, struct ColorLine **ptr, bool free_
   regfree(&cl->regex);
   mutt_pattern_free(&cl->color_pattern);
   FREE(&cl->pattern);
+  FREE(&cl->literal);
   FREE(ptr);
 }
 
@@ -936,6 +937,28 @@ enum CommandResult mutt_parse_unmono(struct Buffer *buf, struct Buffer *s,
   return parse_uncolor(buf, s, data, err, false);
 }
 
+/**
+ * regex_looks_behind - Does a regex test the text before a match?
+ * @param pattern Extended regex
+ * @retval true The regex uses a word boundary or start-of-buffer anchor
+ *
+ * The result is only a hint: a false positive is harmless.
+ */
+static bool regex_looks_behind(const char *pattern)
+{
+  for (const char *p = pattern; *p; p++)
+  {
+    if ((p[0] == '\\') && p[1])
+    {
+      if (strchr("<>bB`", p[1]))
+        return true;
+      p++;
+    }
+  }
+
+  return strstr(pattern, "[:<:]") || strstr(pattern, "[:>:]");
+}
+
 /**
  * add_pattern - Associate a colour to a pattern
  * @param c         Colours
@@ -1022,6 +1045,9 @@ static enum CommandResult add_pattern(struct Colors *c, struct ColorLineList *to
         color_line_free(c, &tmp, true);
         return MUTT_CMD_ERROR;
       }
+      tmp->literal_icase = (flags & REG_ICASE);
+      tmp->literal = mutt_regex_literal(s, tmp->literal_icase);
+      tmp->look_behind = regex_looks_behind(s);
     }
     tmp->pattern = mutt_str_strdup(s);
     tmp->match = match;
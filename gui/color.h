@@ -43,7 +43,12 @@ struct ColorLine
   uint32_t bg;                       ///< Background colour
   int pair;                          ///< Colour pair index
 
+  char *literal;                     ///< Text that every match of the regex contains, or NULL
+  bool literal_icase : 1;            ///< The regex ignores case (literal is lower case)
+  bool look_behind : 1;              ///< The regex tests the text before a match, e.g. "\<"
+
   bool stop_matching : 1;            ///< Used by the pager for body patterns, to prevent the color from being retried once it fails
+  regmatch_t next_match;             ///< Used by the pager for body patterns, the last match in the line (rm_so = -1 if none)
 
   STAILQ_ENTRY(ColorLine) entries;   ///< Linked list
 };
@@ -172,6 +172,32 @@ static int mutt_monitor_getch(void)
 }
 #endif /* USE_INOTIFY */
 
+/**
+ * mutt_input_pending - Is there any input waiting?
+ * @retval true A key, a macro, or a resize is waiting to be handled
+ *
+ * The keyboard is checked without waiting.  A key that's been typed is
+ * pushed back, to be read by mutt_getch().
+ */
+bool mutt_input_pending(void)
+{
+  if (UngetCount || (!OptIgnoreMacroEvents && MacroBufferCount))
+    return true;
+
+  if (SigInt || SigWinch)
+    return true;
+
+  /* ncurses has its own internal buffer, so poll() isn't enough */
+  timeout(0);
+  int ch = getch();
+  timeout(MuttGetchTimeout);
+  if (ch == ERR)
+    return false;
+
+  ungetch(ch);
+  return true;
+}
+
 /**
  * mutt_getch - Read a character from the input buffer
  * @retval obj KeyEvent to process
@@ -1785,6 +1785,44 @@ bool mutt_can_decode(struct Body *a)
   return false;
 }
 
+/**
+ * mutt_body_is_verbatim - Would the handler copy a part unchanged?
+ * @param b Body of the part
+ * @retval true The part is plain text that needs no decoding
+ *
+ * For such a part, mutt_body_handler() (without a prefix) copies the text
+ * unchanged, apart from removing CRs from the line endings, as long as it
+ * only contains ASCII.  The caller must check the text is ASCII.
+ */
+bool mutt_body_is_verbatim(struct Body *b)
+{
+  if (!b || (b->type != TYPE_TEXT) || (mutt_str_strcasecmp("plain", b->subtype) != 0))
+    return false;
+
+  if ((b->encoding != ENC_7BIT) && (b->encoding != ENC_8BIT) && (b->encoding != ENC_BINARY))
+    return false;
+
+  /* The handler wouldn't be run, or would change the text */
+  if (C_HonorDisposition && (b->disposition == DISP_ATTACH) && !OptViewAttach)
+    return false;
+  if (is_autoview(b) || (((WithCrypto & APPLICATION_PGP) != 0) && mutt_is_application_pgp(b)))
+    return false;
+  if (C_TextFlowed || (C_ReflowText && (mutt_str_strcasecmp("flowed",
+                                        mutt_param_get(&b->parameter, "format")) == 0)))
+  {
+    return false;
+  }
+
+  /* The character set conversion must leave ASCII alone */
+  const char *charset = mutt_param_get(&b->parameter, "charset");
+  if (!charset && C_AssumedCharset)
+    charset = mutt_ch_get_default_charset();
+
+  return !charset || mutt_ch_is_utf8(charset) || mutt_ch_is_us_ascii(charset) ||
+         mutt_str_startswith(charset, "iso-8859-", CASE_IGNORE) ||
+         mutt_str_startswith(charset, "windows-125", CASE_IGNORE);
+}
+
 /**
  * mutt_decode_attachment - Decode an email's attachment
  * @param b Body of the email
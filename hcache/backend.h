@@ -26,8 +26,17 @@
 #ifndef MUTT_HCACHE_BACKEND_H
 #define MUTT_HCACHE_BACKEND_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 
+/**
+ * typedef hcache_peek_t - Prototype for a callback from HcacheOps::peek()
+ * @param data  Data of the record
+ * @param dlen  Length of the data
+ * @param udata Private data passed to peek()
+ */
+typedef void (*hcache_peek_t)(const void *data, size_t dlen, void *udata);
+
 /**
  * struct HcacheOps - Header Cache API
  */
@@ -66,6 +75,21 @@ struct HcacheOps
    */
   void (*free)(void *ctx, void **data);
 
+  /**
+   * peek - backend-specific routine to look at a message's headers in place
+   * @param ctx    The backend-specific context retrieved via open()
+   * @param key    A message identification string
+   * @param keylen The length of the string pointed to by key
+   * @param cb     Function to call with the data, if it's found
+   * @param udata  Private data passed to the callback
+   * @retval true The data was found and passed to the callback
+   *
+   * Unlike fetch(), the data isn't copied for the caller.  Where the database
+   * allows it, the callback sees the record in the database's own memory, so
+   * the data is only valid until the callback returns.
+   */
+  bool (*peek)(void *ctx, const char *key, size_t keylen, hcache_peek_t cb, void *udata);
+
   /**
    * store - backend-specific routine to store a message's headers
    * @param ctx     The backend-specific context retrieved via open()
@@ -88,6 +112,25 @@ struct HcacheOps
    */
   int (*delete_header)(void *ctx, const char *key, size_t keylen);
 
+  /**
+   * begin - backend-specific routine to start a batch of changes
+   * @param ctx The backend-specific context retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Until commit() is called, the database may defer writing the changes made
+   * by store() and delete_header().
+   */
+  int (*begin)(void *ctx);
+
+  /**
+   * commit - backend-specific routine to write a batch of changes
+   * @param ctx The backend-specific context retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   */
+  int (*commit)(void *ctx);
+
   /**
    * close - backend-specific routine to close a context
    * @param[out] ctx The backend-specific context retrieved via open()
@@ -111,8 +154,11 @@ struct HcacheOps
     .open    = hcache_##_name##_open,                                          \
     .fetch   = hcache_##_name##_fetch,                                         \
     .free    = hcache_##_name##_free,                                          \
+    .peek    = hcache_##_name##_peek,                                          \
     .store   = hcache_##_name##_store,                                         \
     .delete_header  = hcache_##_name##_delete_header,                          \
+    .begin   = hcache_##_name##_begin,                                         \
+    .commit  = hcache_##_name##_commit,                                        \
     .close   = hcache_##_name##_close,                                         \
     .backend = hcache_##_name##_backend,                                       \
   };
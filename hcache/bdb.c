@@ -51,6 +51,7 @@ struct HcacheDbCtx
   DB *db;
   int fd;
   struct Buffer lockfile;
+  void *peekbuf; ///< Reusable buffer for peek()
 };
 
 /**
@@ -98,6 +99,7 @@ static void *hcache_bdb_open(const char *path)
   if (pagesize <= 0)
     pagesize = 16384;
 
+  ctx->peekbuf = NULL;
   ctx->lockfile = mutt_buffer_make(128);
   mutt_buffer_printf(&ctx->lockfile, "%s-lock-hack", path);
 
@@ -182,6 +184,35 @@ static void hcache_bdb_free(void *vctx, void **data)
   FREE(data);
 }
 
+/**
+ * hcache_bdb_peek - Implements HcacheOps::peek()
+ *
+ * The record is copied into a buffer that's reused from one call to the next.
+ */
+static bool hcache_bdb_peek(void *vctx, const char *key, size_t keylen,
+                            hcache_peek_t cb, void *udata)
+{
+  if (!vctx)
+    return false;
+
+  DBT dkey;
+  DBT data;
+
+  struct HcacheDbCtx *ctx = vctx;
+
+  dbt_init(&dkey, (void *) key, keylen);
+  dbt_init(&data, ctx->peekbuf, 0);
+  data.flags = DB_DBT_REALLOC;
+
+  int rc = ctx->db->get(ctx->db, NULL, &dkey, &data, 0);
+  ctx->peekbuf = data.data;
+  if (rc != 0)
+    return false;
+
+  cb(data.data, data.size, udata);
+  return true;
+}
+
 /**
  * hcache_bdb_store - Implements HcacheOps::store()
  */
@@ -221,6 +252,31 @@ static int hcache_bdb_delete_header(void *vctx, const char *key, size_t keylen)
   return ctx->db->del(ctx->db, NULL, &dkey, 0);
 }
 
+/**
+ * hcache_bdb_begin - Implements HcacheOps::begin()
+ *
+ * The environment isn't transactional.  Changes are left in the memory pool
+ * and flushed when the database is closed, as they always have been.
+ */
+static int hcache_bdb_begin(void *vctx)
+{
+  if (!vctx)
+    return -1;
+
+  return 0;
+}
+
+/**
+ * hcache_bdb_commit - Implements HcacheOps::commit()
+ */
+static int hcache_bdb_commit(void *vctx)
+{
+  if (!vctx)
+    return -1;
+
+  return 0;
+}
+
 /**
  * hcache_bdb_close - Implements HcacheOps::close()
  */
@@ -237,6 +293,7 @@ static void hcache_bdb_close(void **ptr)
   close(db->fd);
   unlink(mutt_b2s(&db->lockfile));
   mutt_buffer_dealloc(&db->lockfile);
+  FREE(&db->peekbuf);
   FREE(ptr);
 }
 
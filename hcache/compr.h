@@ -55,16 +55,17 @@ struct ComprOps
 
   /**
    * decompress - Decompress header cache data
-   * @param[in] cctx Compression context
-   * @param[in] cbuf Data to be decompressed
-   * @param[in] clen Length of the compressed input data
+   * @param[in]  cctx Compression context
+   * @param[in]  cbuf Data to be decompressed
+   * @param[in]  clen Length of the compressed input data
+   * @param[out] ulen Length of the decompressed data
    * @retval ptr  Success, pointer to decompressed data
    * @retval NULL Otherwise
    *
    * @note This function returns a pointer to data, which will be freed by the
    *       close() function.
    */
-  void *(*decompress)(void *cctx, const char *cbuf, size_t clen);
+  void *(*decompress)(void *cctx, const char *cbuf, size_t clen, size_t *ulen);
 
   /**
    * close - Close a compression context
@@ -89,25 +89,28 @@ static void *compr_lz4_compress(void *cctx, const char *data, size_t dlen, size_
 /**
  * compr_lz4_decompress - Implements ComprOps::decompress()
  */
-static void *compr_lz4_decompress(void *cctx, const char *cbuf, size_t clen)
+static void *compr_lz4_decompress(void *cctx, const char *cbuf, size_t clen, size_t *ulen)
 {
-  if (!cctx)
+  if (!cctx || (clen < 4))
     return NULL;
 
   struct ComprLz4Ctx *ctx = cctx;
 
   /* first 4 bytes store the size */
   const unsigned char *cs = (const unsigned char *) cbuf;
-  size_t ulen = cs[0] + (cs[1] << 8) + (cs[2] << 16) + (cs[3] << 24);
-  if (ulen == 0)
+  size_t len = cs[0] + (cs[1] << 8) + (cs[2] << 16) + (cs[3] << 24);
+  *ulen = 0;
+  if (len == 0)
     return (void *) cbuf;
 
-  mutt_mem_realloc(&ctx->buf, ulen);
+  mutt_mem_realloc(&ctx->buf, len);
   void *ubuf = ctx->buf;
   const char *data = cbuf;
-  int ret = LZ4_decompress_safe(data + 4, ubuf, clen - 4, ulen);
+  int ret = LZ4_decompress_safe(data + 4, ubuf, clen - 4, len);
   if (ret < 0)
     mutt_error("LZ4_decompress_safe() failed!");
+  else
+    *ulen = ret;
 
   return ubuf;
 }
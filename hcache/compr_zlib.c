@@ -89,25 +89,28 @@ static void *compr_zlib_compress(void *cctx, const char *data, size_t dlen, size
 /**
  * compr_zlib_decompress - Implements ComprOps::decompress()
  */
-static void *compr_zlib_decompress(void *cctx, const char *cbuf, size_t clen)
+static void *compr_zlib_decompress(void *cctx, const char *cbuf, size_t clen, size_t *ulen)
 {
-  if (!cctx)
+  if (!cctx || (clen < 4))
     return NULL;
 
   struct ComprZlibCtx *ctx = cctx;
 
   /* first 4 bytes store the size */
   const unsigned char *cs = (const unsigned char *) cbuf;
-  uLong ulen = cs[0] + (cs[1] << 8) + (cs[2] << 16) + (cs[3] << 24);
-  if (ulen == 0)
+  uLong len = cs[0] + (cs[1] << 8) + (cs[2] << 16) + (cs[3] << 24);
+  *ulen = 0;
+  if (len == 0)
     return (void *) cbuf;
 
-  mutt_mem_realloc(&ctx->buf, ulen);
+  mutt_mem_realloc(&ctx->buf, len);
   Bytef *ubuf = ctx->buf;
   cs = (const unsigned char *) cbuf;
-  int ret = uncompress(ubuf, &ulen, cs + 4, clen - 4);
+  int ret = uncompress(ubuf, &len, cs + 4, clen - 4);
   if (ret != Z_OK)
     mutt_error("Zlib uncompress() failed!");
+  else
+    *ulen = len;
 
   return ubuf;
 }
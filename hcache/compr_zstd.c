@@ -116,7 +116,7 @@ static void *compr_zstd_compress(void *cctx, const char *data, size_t dlen, size
 /**
  * compr_zstd_decompress - Implements ComprOps::decompress()
  */
-static void *compr_zstd_decompress(void *cctx, const char *cbuf, size_t clen)
+static void *compr_zstd_decompress(void *cctx, const char *cbuf, size_t clen, size_t *ulen)
 {
   struct ComprZstdCtx *ctx = cctx;
 
@@ -129,8 +129,11 @@ static void *compr_zstd_decompress(void *cctx, const char *cbuf, size_t clen)
   else
     ret = ZSTD_decompressDCtx(ctx->dctx, ctx->buf, len, cbuf, clen);
 
+  *ulen = 0;
   if (ZSTD_isError(ret))
     mutt_error("ZSTD_decompress() failed!");
+  else
+    *ulen = ret;
 
   return ctx->buf;
 }
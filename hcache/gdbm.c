@@ -82,6 +82,24 @@ static void hcache_gdbm_free(void *vctx, void **data)
   FREE(data);
 }
 
+/**
+ * hcache_gdbm_peek - Implements HcacheOps::peek()
+ *
+ * GDBM always returns a copy of the record, so this is only a convenience.
+ */
+static bool hcache_gdbm_peek(void *ctx, const char *key, size_t keylen,
+                             hcache_peek_t cb, void *udata)
+{
+  size_t dlen = 0;
+  void *data = hcache_gdbm_fetch(ctx, key, keylen, &dlen);
+  if (!data)
+    return false;
+
+  cb(data, dlen, udata);
+  FREE(&data);
+  return true;
+}
+
 /**
  * hcache_gdbm_store - Implements HcacheOps::store()
  */
@@ -122,6 +140,31 @@ static int hcache_gdbm_delete_header(void *ctx, const char *key, size_t keylen)
   return gdbm_delete(db, dkey);
 }
 
+/**
+ * hcache_gdbm_begin - Implements HcacheOps::begin()
+ *
+ * GDBM has no transactions.  Changes are written as they are made and flushed
+ * when the database is closed, as they always have been.
+ */
+static int hcache_gdbm_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  return 0;
+}
+
+/**
+ * hcache_gdbm_commit - Implements HcacheOps::commit()
+ */
+static int hcache_gdbm_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  return 0;
+}
+
 /**
  * hcache_gdbm_close - Implements HcacheOps::close()
  */
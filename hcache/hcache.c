@@ -433,7 +433,7 @@ void mutt_hcache_close(header_cache_t *hc)
  */
 void *mutt_hcache_fetch(header_cache_t *hc, const char *key, size_t keylen)
 {
-  void *data = mutt_hcache_fetch_raw(hc, key, keylen);
+  void *data = mutt_hcache_fetch_raw(hc, key, keylen, NULL);
   if (!data)
   {
     return NULL;
@@ -450,9 +450,10 @@ void *mutt_hcache_fetch(header_cache_t *hc, const char *key, size_t keylen)
 
 /**
  * mutt_hcache_fetch_raw - Fetch a message's header from the cache
- * @param hc     Pointer to the header_cache_t structure got by mutt_hcache_open()
- * @param key    Message identification string
- * @param keylen Length of the string pointed to by key
+ * @param[in]  hc     Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @param[in]  key    Message identification string
+ * @param[in]  keylen Length of the string pointed to by key
+ * @param[out] dlen   Length of the data (OPTIONAL)
  * @retval ptr  Success, the data if found
  * @retval NULL Otherwise
  *
@@ -461,7 +462,8 @@ void *mutt_hcache_fetch(header_cache_t *hc, const char *key, size_t keylen)
  * @note The returned pointer must be freed by calling mutt_hcache_free. This
  *       must be done before closing the header cache with mutt_hcache_close.
  */
-void *mutt_hcache_fetch_raw(header_cache_t *hc, const char *key, size_t keylen)
+void *mutt_hcache_fetch_raw(header_cache_t *hc, const char *key,
+                            size_t keylen, size_t *dlen)
 {
   const struct HcacheOps *ops = hcache_get_ops();
 
@@ -469,20 +471,26 @@ void *mutt_hcache_fetch_raw(header_cache_t *hc, const char *key, size_t keylen)
     return NULL;
 
   struct Buffer path = mutt_buffer_make(1024);
-  size_t dlen;
+  size_t len = 0;
   keylen = mutt_buffer_printf(&path, "%s%s", hc->folder, key);
-  void *blob = ops->fetch(hc->ctx, mutt_b2s(&path), keylen, &dlen);
+  void *blob = ops->fetch(hc->ctx, mutt_b2s(&path), keylen, &len);
   mutt_buffer_dealloc(&path);
 
 #ifdef USE_HCACHE_COMPRESSION
   if (C_HeaderCacheCompressMethod && blob != NULL)
   {
     const struct ComprOps *cops = compr_get_ops();
-    hc->ondisk = blob;
-    blob = cops->decompress(hc->cctx, blob, dlen);
+    void *ondisk = blob;
+    blob = cops->decompress(hc->cctx, ondisk, len, &len);
+    if (blob)
+      hc->ondisk = ondisk;
+    else
+      ops->free(hc->ctx, &ondisk);
   }
 #endif
 
+  if (dlen)
+    *dlen = blob ? len : 0;
   return blob;
 }
 
@@ -508,6 +516,104 @@ void mutt_hcache_free(header_cache_t *hc, void **data)
   ops->free(hc->ctx, data);
 }
 
+/**
+ * struct HcachePeek - A consumer of a header cache record
+ */
+struct HcachePeek
+{
+  header_cache_t *hc;               ///< Header cache
+  const unsigned int *uidvalidity;  ///< Validity datum the record must have, or NULL for any
+  hcache_fetch_t cb;                ///< Function to call with a valid record
+  size_t index;                     ///< Index to pass to the callback
+  void *udata;                      ///< Private data to pass to the callback
+  bool valid;                       ///< The record was valid
+};
+
+/**
+ * hcache_peek_cb - Validate a record and pass it on - Implements ::hcache_peek_t
+ */
+static void hcache_peek_cb(const void *data, size_t dlen, void *udata)
+{
+  struct HcachePeek *hp = udata;
+
+  if (dlen < (sizeof(size_t) + sizeof(unsigned int)))
+    return;
+
+#ifdef USE_HCACHE_COMPRESSION
+  if (C_HeaderCacheCompressMethod)
+  {
+    const struct ComprOps *cops = compr_get_ops();
+    data = cops->decompress(hp->hc->cctx, data, dlen, &dlen);
+    if (!data || (dlen < (sizeof(size_t) + sizeof(unsigned int))))
+      return;
+  }
+#endif
+
+  if (!crc_matches(data, hp->hc->crc))
+    return;
+
+  if (hp->uidvalidity)
+  {
+    size_t uidvalidity;
+    memcpy(&uidvalidity, data, sizeof(uidvalidity));
+    if (uidvalidity != *hp->uidvalidity)
+    {
+      mutt_debug(LL_DEBUG3, "hcache uidvalidity mismatch: %zu\n", uidvalidity);
+      return;
+    }
+  }
+
+  hp->valid = true;
+  hp->cb(data, hp->index, hp->udata);
+}
+
+/**
+ * hcache_peek - Look at a record without copying it
+ * @param hp     Consumer of the record
+ * @param key    Message identification string
+ * @param keylen Length of the string pointed to by key
+ * @retval true The record was found, was valid and was passed to the callback
+ */
+static bool hcache_peek(struct HcachePeek *hp, const char *key, size_t keylen)
+{
+  const struct HcacheOps *ops = hcache_get_ops();
+  if (!ops)
+    return false;
+
+  /* Like mutt_hcache_store_raw(), use the whole key, whatever keylen says */
+  struct Buffer *path = mutt_buffer_pool_get();
+  keylen = mutt_buffer_printf(path, "%s%s", hp->hc->folder, key);
+
+  hp->valid = false;
+  ops->peek(hp->hc->ctx, mutt_b2s(path), keylen, hcache_peek_cb, hp);
+  mutt_buffer_pool_release(&path);
+  return hp->valid;
+}
+
+/**
+ * hcache_restore_cb - Restore an Email - Implements ::hcache_fetch_t
+ */
+static void hcache_restore_cb(const void *data, size_t index, void *udata)
+{
+  struct Email **e = udata;
+  *e = mutt_hcache_restore(data);
+}
+
+/**
+ * mutt_hcache_fetch_email - Fetch, validate and restore a message's header
+ */
+struct Email *mutt_hcache_fetch_email(header_cache_t *hc, const char *key,
+                                      size_t keylen, const unsigned int *uidvalidity)
+{
+  if (!hc || !key)
+    return NULL;
+
+  struct Email *e = NULL;
+  struct HcachePeek hp = { hc, uidvalidity, hcache_restore_cb, 0, &e, false };
+  hcache_peek(&hp, key, keylen);
+  return e;
+}
+
 /**
  * mutt_hcache_store - Multiplexor for HcacheOps::store
  */
@@ -583,6 +689,143 @@ int mutt_hcache_delete_header(header_cache_t *hc, const char *key, size_t keylen
   return rc;
 }
 
+/**
+ * mutt_hcache_begin - Multiplexor for HcacheOps::begin
+ *
+ * Kyoto and Tokyo Cabinet would wait for their own transaction to end, and
+ * QDBM would end it early, so only the outermost batch reaches the backend.
+ */
+int mutt_hcache_begin(header_cache_t *hc)
+{
+  const struct HcacheOps *ops = hcache_get_ops();
+  if (!hc || !ops)
+    return -1;
+
+  if (hc->batch++ > 0)
+    return 0;
+
+  return ops->begin(hc->ctx);
+}
+
+/**
+ * mutt_hcache_commit - Multiplexor for HcacheOps::commit
+ */
+int mutt_hcache_commit(header_cache_t *hc)
+{
+  const struct HcacheOps *ops = hcache_get_ops();
+  if (!hc || !ops || (hc->batch == 0))
+    return -1;
+
+  if (--hc->batch > 0)
+    return 0;
+
+  return ops->commit(hc->ctx);
+}
+
+/**
+ * struct HcacheBatchKey - A key in a batch of fetches or stores
+ */
+struct HcacheBatchKey
+{
+  const char *key; ///< Message identification string
+  size_t keylen;   ///< Length of the key
+  size_t index;    ///< Position of the key in the caller's arrays
+};
+
+/**
+ * batch_key_cmp - Compare two keys of a batch - Implements ::sort_t
+ */
+static int batch_key_cmp(const void *a, const void *b)
+{
+  const struct HcacheBatchKey *ka = a;
+  const struct HcacheBatchKey *kb = b;
+
+  int rc = memcmp(ka->key, kb->key, MIN(ka->keylen, kb->keylen));
+  if (rc != 0)
+    return rc;
+  return (ka->keylen > kb->keylen) - (ka->keylen < kb->keylen);
+}
+
+/**
+ * batch_keys_sort - Put the keys of a batch in the database's order
+ * @param keys    Message identification strings
+ * @param keylens Lengths of the keys, or NULL if they're all NUL-terminated
+ * @param num     Number of keys
+ * @retval ptr Sorted array of keys, to be freed by the caller
+ *
+ * The backends all keep their records in a lexically ordered tree, so visiting
+ * the keys in order keeps the accesses close together.
+ */
+static struct HcacheBatchKey *batch_keys_sort(const char **keys,
+                                              const size_t *keylens, size_t num)
+{
+  struct HcacheBatchKey *bk = mutt_mem_calloc(num, sizeof(struct HcacheBatchKey));
+
+  for (size_t i = 0; i < num; i++)
+  {
+    bk[i].key = keys[i];
+    bk[i].keylen = keylens ? keylens[i] : strlen(keys[i]);
+    bk[i].index = i;
+  }
+
+  qsort(bk, num, sizeof(struct HcacheBatchKey), batch_key_cmp);
+  return bk;
+}
+
+/**
+ * mutt_hcache_fetch_n - Fetch and validate many messages' headers
+ */
+size_t mutt_hcache_fetch_n(header_cache_t *hc, const char **keys, const size_t *keylens,
+                           size_t num, hcache_fetch_t cb, void *udata)
+{
+  if (!hc || !keys || !cb || (num == 0))
+    return 0;
+
+  size_t found = 0;
+  struct HcacheBatchKey *bk = batch_keys_sort(keys, keylens, num);
+  struct HcachePeek hp = { hc, NULL, cb, 0, udata, false };
+
+  for (size_t i = 0; i < num; i++)
+  {
+    hp.index = bk[i].index;
+    if (hcache_peek(&hp, bk[i].key, bk[i].keylen))
+      found++;
+  }
+
+  FREE(&bk);
+  return found;
+}
+
+/**
+ * mutt_hcache_store_n - Store many Emails in one batch
+ */
+int mutt_hcache_store_n(header_cache_t *hc, const char **keys, const size_t *keylens,
+                        struct Email **emails, size_t num, unsigned int uidvalidity)
+{
+  if (!hc || !keys || !emails)
+    return -1;
+  if (num == 0)
+    return 0;
+
+  int rc = 0;
+  struct HcacheBatchKey *bk = batch_keys_sort(keys, keylens, num);
+
+  mutt_hcache_begin(hc);
+  for (size_t i = 0; i < num; i++)
+  {
+    int rc2 = mutt_hcache_store(hc, bk[i].key, bk[i].keylen, emails[bk[i].index], uidvalidity);
+    if (rc == 0)
+      rc = rc2;
+  }
+
+  int rc2 = mutt_hcache_commit(hc);
+  if (rc == 0)
+    rc = rc2;
+
+  FREE(&bk);
+  return rc;
+}
+
 /**
  * mutt_hcache_backend_list - Get a list of backend names
  * @retval ptr Comma-space-separated list of names
@@ -84,6 +84,53 @@ static void hcache_kyotocabinet_free(void *vctx, void **data)
   *data = NULL;
 }
 
+/**
+ * struct KcPeek - Callback for hcache_kyotocabinet_peek()
+ */
+struct KcPeek
+{
+  hcache_peek_t cb; ///< Caller's callback
+  void *udata;      ///< Caller's private data
+  bool found;       ///< The record exists
+};
+
+/**
+ * kc_visit_full - Pass an existing record to the caller - Implements ::KCVISITFULL
+ */
+static const char *kc_visit_full(const char *kbuf, size_t ksiz, const char *vbuf,
+                                 size_t vsiz, size_t *sp, void *opq)
+{
+  struct KcPeek *kp = opq;
+  kp->found = true;
+  kp->cb(vbuf, vsiz, kp->udata);
+  return KCVISNOP;
+}
+
+/**
+ * kc_visit_empty - Ignore a missing record - Implements ::KCVISITEMPTY
+ */
+static const char *kc_visit_empty(const char *kbuf, size_t ksiz, size_t *sp, void *opq)
+{
+  return KCVISNOP;
+}
+
+/**
+ * hcache_kyotocabinet_peek - Implements HcacheOps::peek()
+ *
+ * A read-only visitor sees the record without it being copied.
+ */
+static bool hcache_kyotocabinet_peek(void *ctx, const char *key, size_t keylen,
+                                     hcache_peek_t cb, void *udata)
+{
+  if (!ctx)
+    return false;
+
+  KCDB *db = ctx;
+  struct KcPeek kp = { cb, udata, false };
+  kcdbaccept(db, key, keylen, kc_visit_full, kc_visit_empty, &kp, false);
+  return kp.found;
+}
+
 /**
  * hcache_kyotocabinet_store - Implements HcacheOps::store()
  */
@@ -119,6 +166,40 @@ static int hcache_kyotocabinet_delete_header(void *ctx, const char *key, size_t
   return 0;
 }
 
+/**
+ * hcache_kyotocabinet_begin - Implements HcacheOps::begin()
+ */
+static int hcache_kyotocabinet_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  KCDB *db = ctx;
+  if (!kcdbbegintran(db, false))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * hcache_kyotocabinet_commit - Implements HcacheOps::commit()
+ */
+static int hcache_kyotocabinet_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  KCDB *db = ctx;
+  if (!kcdbendtran(db, true))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * hcache_kyotocabinet_close - Implements HcacheOps::close()
  */
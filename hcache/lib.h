@@ -79,6 +79,7 @@ struct EmailCache
   void *ctx;
   void *cctx;
   void *ondisk;
+  int batch; ///< Depth of nested batches, see mutt_hcache_begin()
 };
 
 typedef struct EmailCache header_cache_t;
@@ -90,6 +91,16 @@ typedef struct EmailCache header_cache_t;
  */
 typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
 
+/**
+ * typedef hcache_fetch_t - Prototype for a callback from mutt_hcache_fetch_n()
+ * @param data  Message's headers, validated as by mutt_hcache_fetch()
+ * @param index Index of the message's key
+ * @param udata Private data passed to mutt_hcache_fetch_n()
+ *
+ * The data is only valid until the callback returns.
+ */
+typedef void (*hcache_fetch_t)(const void *data, size_t index, void *udata);
+
 /* These Config Variables are only used in hcache/hcache.c */
 extern char *C_HeaderCacheBackend;
 extern char *C_HeaderCacheCompressDictionary;
@@ -129,7 +140,8 @@ void mutt_hcache_close(header_cache_t *hc);
  */
 void *mutt_hcache_fetch(header_cache_t *hc, const char *key, size_t keylen);
 
-void *mutt_hcache_fetch_raw(header_cache_t *hc, const char *key, size_t keylen);
+void *mutt_hcache_fetch_raw(header_cache_t *hc, const char *key,
+                            size_t keylen, size_t *dlen);
 
 /**
  * mutt_hcache_free - free previously fetched data
@@ -140,6 +152,22 @@ void mutt_hcache_free(header_cache_t *hc, void **data);
 
 struct Email *mutt_hcache_restore(const unsigned char *d);
 
+/**
+ * mutt_hcache_fetch_email - fetch, validate and restore a message's header
+ * @param hc          Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @param key         Message identification string
+ * @param keylen      Length of the string pointed to by key
+ * @param uidvalidity IMAP-specific UIDVALIDITY value the data must have, or NULL for any
+ * @retval ptr  Success, the restored Email, which must be freed with email_free()
+ * @retval NULL Otherwise
+ *
+ * Unlike mutt_hcache_fetch() followed by mutt_hcache_restore(), the Email is
+ * restored straight from the database's memory (or the decompression buffer),
+ * without an intermediate copy of the data.
+ */
+struct Email *mutt_hcache_fetch_email(header_cache_t *hc, const char *key,
+                                      size_t keylen, const unsigned int *uidvalidity);
+
 /**
  * mutt_hcache_store - store a Header along with a validity datum
  * @param hc          Pointer to the header_cache_t structure got by mutt_hcache_open()
@@ -166,6 +194,57 @@ int mutt_hcache_store_raw(header_cache_t *hc, const char *key, size_t keylen,
  */
 int mutt_hcache_delete_header(header_cache_t *hc, const char *key, size_t keylen);
 
+/**
+ * mutt_hcache_begin - start a batch of changes
+ * @param hc Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * Stores and deletes may be deferred until mutt_hcache_commit() is called,
+ * saving the backend from committing each one separately.
+ *
+ * Batches may be nested.  Only the outermost one is a transaction of the
+ * backend, so an inner mutt_hcache_commit() doesn't end it.
+ */
+int mutt_hcache_begin(header_cache_t *hc);
+
+/**
+ * mutt_hcache_commit - write a batch of changes
+ * @param hc Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ */
+int mutt_hcache_commit(header_cache_t *hc);
+
+/**
+ * mutt_hcache_fetch_n - fetch and validate many messages' headers
+ * @param hc      Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @param keys    Message identification strings
+ * @param keylens Lengths of the keys, or NULL if they're all NUL-terminated
+ * @param num     Number of keys
+ * @param cb      Function to call for each message found
+ * @param udata   Private data passed to the callback
+ * @retval num Number of messages found
+ *
+ * The keys are looked up in the database's order, not the order given.
+ */
+size_t mutt_hcache_fetch_n(header_cache_t *hc, const char **keys, const size_t *keylens,
+                           size_t num, hcache_fetch_t cb, void *udata);
+
+/**
+ * mutt_hcache_store_n - store many Headers in one batch
+ * @param hc          Pointer to the header_cache_t structure got by mutt_hcache_open()
+ * @param keys        Message identification strings
+ * @param keylens     Lengths of the keys, or NULL if they're all NUL-terminated
+ * @param emails      Emails to store, one for each key
+ * @param num         Number of Emails
+ * @param uidvalidity IMAP-specific UIDVALIDITY value, or 0 to use the current time
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ */
+int mutt_hcache_store_n(header_cache_t *hc, const char **keys, const size_t *keylens,
+                        struct Email **emails, size_t num, unsigned int uidvalidity);
+
 /**
  * mutt_hcache_backend_list - get a list of backend identification strings
  * @retval ptr Comma separated string describing the compiled-in backends
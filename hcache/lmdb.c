@@ -217,6 +217,23 @@ static void hcache_lmdb_free(void *vctx, void **data)
   /* LMDB data is owned by the database */
 }
 
+/**
+ * hcache_lmdb_peek - Implements HcacheOps::peek()
+ *
+ * The callback reads the record straight from the database's memory map.
+ */
+static bool hcache_lmdb_peek(void *vctx, const char *key, size_t keylen,
+                             hcache_peek_t cb, void *udata)
+{
+  size_t dlen = 0;
+  void *data = hcache_lmdb_fetch(vctx, key, keylen, &dlen);
+  if (!data)
+    return false;
+
+  cb(data, dlen, udata);
+  return true;
+}
+
 /**
  * hcache_lmdb_store - Implements HcacheOps::store()
  */
@@ -283,6 +300,40 @@ static int hcache_lmdb_delete_header(void *vctx, const char *key, size_t keylen)
   return rc;
 }
 
+/**
+ * hcache_lmdb_begin - Implements HcacheOps::begin()
+ */
+static int hcache_lmdb_begin(void *vctx)
+{
+  if (!vctx)
+    return -1;
+
+  return mdb_get_w_txn(vctx);
+}
+
+/**
+ * hcache_lmdb_commit - Implements HcacheOps::commit()
+ */
+static int hcache_lmdb_commit(void *vctx)
+{
+  if (!vctx)
+    return -1;
+
+  struct HcacheLmdbCtx *ctx = vctx;
+
+  if (!ctx->txn || (ctx->txn_mode != TXN_WRITE))
+    return MDB_SUCCESS;
+
+  /* The transaction is freed, even if the commit fails */
+  int rc = mdb_txn_commit(ctx->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  ctx->txn_mode = TXN_UNINITIALIZED;
+  ctx->txn = NULL;
+  return rc;
+}
+
 /**
  * hcache_lmdb_close - Implements HcacheOps::close()
  */
@@ -74,6 +74,27 @@ static void hcache_qdbm_free(void *ctx, void **data)
   FREE(data);
 }
 
+/**
+ * hcache_qdbm_peek - Implements HcacheOps::peek()
+ *
+ * The record is read from the database's cache, without a copy.
+ */
+static bool hcache_qdbm_peek(void *ctx, const char *key, size_t keylen,
+                             hcache_peek_t cb, void *udata)
+{
+  if (!ctx)
+    return false;
+
+  VILLA *db = ctx;
+  int sp = 0;
+  const char *data = vlgetcache(db, key, keylen, &sp);
+  if (!data)
+    return false;
+
+  cb(data, sp, udata);
+  return true;
+}
+
 /**
  * hcache_qdbm_store - Implements HcacheOps::store()
  */
@@ -104,6 +125,32 @@ static int hcache_qdbm_delete_header(void *ctx, const char *key, size_t keylen)
   return success ? 0 : dpecode ? dpecode : -1;
 }
 
+/**
+ * hcache_qdbm_begin - Implements HcacheOps::begin()
+ */
+static int hcache_qdbm_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  VILLA *db = ctx;
+  bool success = vltranbegin(db);
+  return success ? 0 : dpecode ? dpecode : -1;
+}
+
+/**
+ * hcache_qdbm_commit - Implements HcacheOps::commit()
+ */
+static int hcache_qdbm_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  VILLA *db = ctx;
+  bool success = vltrancommit(db);
+  return success ? 0 : dpecode ? dpecode : -1;
+}
+
 /**
  * hcache_qdbm_close - Implements HcacheOps::close()
  */
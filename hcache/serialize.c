@@ -345,6 +345,49 @@ void serial_restore_buffer(struct Buffer *buf, const unsigned char *d, int *off,
   buf->dsize = used;
 }
 
+/**
+ * serial_dump_body_filter - Pack a BodyFilter into a binary blob
+ * @param bf  BodyFilter to pack
+ * @param d   Binary blob to add to
+ * @param off Offset into the blob
+ * @retval ptr End of the newly packed binary
+ */
+unsigned char *serial_dump_body_filter(struct BodyFilter *bf, unsigned char *d, int *off)
+{
+  if (!bf)
+    return serial_dump_int(0, d, off);
+
+  d = serial_dump_int(bf->size, d, off);
+  lazy_realloc(&d, *off + bf->size);
+  memcpy(d + *off, bf->bits, bf->size);
+  *off += bf->size;
+
+  return d;
+}
+
+/**
+ * serial_restore_body_filter - Unpack a BodyFilter from a binary blob
+ * @param[out] bf  Store the unpacked BodyFilter here
+ * @param[in]  d   Binary blob to read from
+ * @param[out] off Offset into the blob
+ */
+void serial_restore_body_filter(struct BodyFilter **bf, const unsigned char *d, int *off)
+{
+  unsigned int size;
+  serial_restore_int(&size, d, off);
+
+  if (size == 0)
+  {
+    *bf = NULL;
+    return;
+  }
+
+  *bf = mutt_mem_malloc(sizeof(struct BodyFilter) + size);
+  (*bf)->size = size;
+  memcpy((*bf)->bits, d + *off, size);
+  *off += size;
+}
+
 /**
  * serial_dump_parameter - Pack a Parameter into a binary blob
  * @param pl      Parameter to pack
@@ -600,18 +643,21 @@ void *mutt_hcache_dump(header_cache_t *hc, const struct Email *e, int *off, size
   nh.matched = false;
   nh.collapsed = false;
   nh.limited = false;
+  nh.limit_checked = false;
   nh.num_hidden = 0;
   nh.recipient = 0;
   nh.pair = 0;
   nh.attach_valid = false;
   nh.path = NULL;
   nh.tree = NULL;
+  nh.index_line = NULL;
   nh.thread = NULL;
   STAILQ_INIT(&nh.tags);
 #ifdef MIXMASTER
   STAILQ_INIT(&nh.chain);
 #endif
   nh.edata = NULL;
+  nh.pattern_memo = NULL;
 
   memcpy(d + *off, &nh, sizeof(struct Email));
   *off += sizeof(struct Email);
@@ -619,6 +665,7 @@ void *mutt_hcache_dump(header_cache_t *hc, const struct Email *e, int *off, size
   d = serial_dump_envelope(nh.env, d, off, convert);
   d = serial_dump_body(nh.content, d, off, convert);
   d = serial_dump_char(nh.maildir_flags, d, off, convert);
+  d = serial_dump_body_filter(nh.body_filter, d, off);
 
   return d;
 }
@@ -658,6 +705,7 @@ struct Email *mutt_hcache_restore(const unsigned char *d)
   serial_restore_body(e->content, d, &off, convert);
 
   serial_restore_char(&e->maildir_flags, d, &off, convert);
+  serial_restore_body_filter(&e->body_filter, d, &off);
 
   return e;
 }
@@ -33,6 +33,7 @@
 
 struct AddressList;
 struct Body;
+struct BodyFilter;
 struct Buffer;
 struct Envelope;
 struct Email;
@@ -41,6 +42,7 @@ struct ParameterList;
 
 unsigned char *serial_dump_address(struct AddressList *al, unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_body(struct Body *c, unsigned char *d, int *off, bool convert);
+unsigned char *serial_dump_body_filter(struct BodyFilter *bf, unsigned char *d, int *off);
 unsigned char *serial_dump_buffer(struct Buffer *buf, unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_char(char *c, unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_char_size(char *c, unsigned char *d, int *off, ssize_t size, bool convert);
@@ -52,6 +54,7 @@ unsigned char *serial_dump_stailq(struct ListHead *l, unsigned char *d, int *off
 
 void           serial_restore_address(struct AddressList *al, const unsigned char *d, int *off, bool convert);
 void           serial_restore_body(struct Body *c, const unsigned char *d, int *off, bool convert);
+void           serial_restore_body_filter(struct BodyFilter **bf, const unsigned char *d, int *off);
 void           serial_restore_buffer(struct Buffer *buf, const unsigned char *d, int *off, bool convert);
 void           serial_restore_char(char **c, const unsigned char *d, int *off, bool convert);
 void           serial_restore_envelope(struct Envelope *e, const unsigned char *d, int *off, bool convert);
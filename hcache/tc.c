@@ -80,6 +80,27 @@ static void hcache_tokyocabinet_free(void *ctx, void **data)
   FREE(data);
 }
 
+/**
+ * hcache_tokyocabinet_peek - Implements HcacheOps::peek()
+ *
+ * The record is read from the database's page cache, without a copy.
+ */
+static bool hcache_tokyocabinet_peek(void *ctx, const char *key, size_t keylen,
+                                     hcache_peek_t cb, void *udata)
+{
+  if (!ctx)
+    return false;
+
+  int sp = 0;
+  TCBDB *db = ctx;
+  const void *data = tcbdbget3(db, key, keylen, &sp);
+  if (!data)
+    return false;
+
+  cb(data, sp, udata);
+  return true;
+}
+
 /**
  * hcache_tokyocabinet_store - Implements HcacheOps::store()
  */
@@ -115,6 +136,40 @@ static int hcache_tokyocabinet_delete_header(void *ctx, const char *key, size_t
   return 0;
 }
 
+/**
+ * hcache_tokyocabinet_begin - Implements HcacheOps::begin()
+ */
+static int hcache_tokyocabinet_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  TCBDB *db = ctx;
+  if (!tcbdbtranbegin(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * hcache_tokyocabinet_commit - Implements HcacheOps::commit()
+ */
+static int hcache_tokyocabinet_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  TCBDB *db = ctx;
+  if (!tcbdbtrancommit(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * hcache_tokyocabinet_close - Implements HcacheOps::close()
  */
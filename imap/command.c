@@ -81,6 +81,7 @@ static const char *const Capabilities[] = {
   "LIST-EXTENDED",
   "COMPRESS=DEFLATE",
   "X-GM-EXT-1",
+  "ESEARCH",
   NULL,
 };
 
@@ -770,6 +771,27 @@ static void cmd_parse_myrights(struct ImapAccountData *adata, const char *s)
   }
 }
 
+/**
+ * search_add_uid - Add a UID to the results of the search in progress
+ * @param adata Imap Account data
+ * @param uid   UID of a matching email
+ *
+ * Only the emails that were searched, i.e. ones we know about, are kept.
+ */
+static void search_add_uid(struct ImapAccountData *adata, unsigned int uid)
+{
+  struct ImapMboxData *mdata = adata->mailbox->mdata;
+  struct ImapSearch *is = mdata->searching;
+  if (!is || (uid > is->uid_max) ||
+      (is->num_uids >= (size_t) adata->mailbox->msg_count))
+  {
+    return;
+  }
+
+  if (mutt_hash_int_find(mdata->uid_hash, uid))
+    is->uids[is->num_uids++] = uid;
+}
+
 /**
  * cmd_parse_search - store SEARCH response for later use
  * @param adata Imap Account data
@@ -778,8 +800,6 @@ static void cmd_parse_myrights(struct ImapAccountData *adata, const char *s)
 static void cmd_parse_search(struct ImapAccountData *adata, const char *s)
 {
   unsigned int uid;
-  struct Email *e = NULL;
-  struct ImapMboxData *mdata = adata->mailbox->mdata;
 
   mutt_debug(LL_DEBUG2, "Handling SEARCH\n");
 
@@ -787,9 +807,62 @@ static void cmd_parse_search(struct ImapAccountData *adata, const char *s)
   {
     if (mutt_str_atoui(s, &uid) < 0)
       continue;
-    e = mutt_hash_int_find(mdata->uid_hash, uid);
-    if (e)
-      e->matched = true;
+    search_add_uid(adata, uid);
+  }
+}
+
+/**
+ * cmd_parse_esearch - store ESEARCH response for later use
+ * @param adata Imap Account data
+ * @param s     Command string with search results
+ *
+ * Only the UID ALL results, as requested by imap_search(), are used, e.g.
+ * `* ESEARCH (TAG "a12") UID ALL 4:6,9`
+ */
+static void cmd_parse_esearch(struct ImapAccountData *adata, char *s)
+{
+  unsigned int uid;
+
+  mutt_debug(LL_DEBUG2, "Handling ESEARCH\n");
+
+  s = imap_next_word(s);
+
+  /* skip the search correlator */
+  if (*s == '(')
+  {
+    s = strchr(s, ')');
+    if (!s)
+      return;
+    s = imap_next_word(s);
+  }
+
+  if (!mutt_str_startswith(s, "UID", CASE_IGNORE))
+  {
+    mutt_debug(LL_DEBUG2, "ESEARCH: ignoring message sequence numbers\n");
+    return;
+  }
+  s = imap_next_word(s);
+
+  while (*s != '\0')
+  {
+    const bool all = mutt_str_startswith(s, "ALL ", CASE_IGNORE);
+    s = imap_next_word(s);
+
+    char *end = s;
+    while (*end && !IS_SPACE(*end))
+      end++;
+
+    if (all)
+    {
+      char *seqset = mutt_str_substr_dup(s, end);
+      struct SeqsetIterator *iter = mutt_seqset_iterator_new(seqset);
+      while (mutt_seqset_iterator_next(iter, &uid) == 0)
+        search_add_uid(adata, uid);
+      mutt_seqset_iterator_free(&iter);
+      FREE(&seqset);
+    }
+
+    s = imap_next_word(end);
   }
 }
 
@@ -1043,6 +1116,8 @@ static int cmd_handle_untagged(struct ImapAccountData *adata)
     cmd_parse_myrights(adata, s);
   else if (mutt_str_startswith(s, "SEARCH", CASE_IGNORE))
     cmd_parse_search(adata, s);
+  else if (mutt_str_startswith(s, "ESEARCH", CASE_IGNORE))
+    cmd_parse_esearch(adata, s);
   else if (mutt_str_startswith(s, "STATUS", CASE_IGNORE))
     cmd_parse_status(adata, s);
   else if (mutt_str_startswith(s, "ENABLED", CASE_IGNORE))
@@ -338,114 +338,91 @@ static int sync_helper(struct Mailbox *m, AclFlags right, int flag, const char *
 }
 
 /**
- * do_search - Perform a search of messages
- * @param search  List of pattern to match
- * @param allpats Must all patterns match?
- * @retval num Number of patterns search that should be done server-side
+ * search_translatable - Can the server evaluate a Pattern?
+ * @param pat Pattern
+ * @retval true The server can evaluate the whole of the Pattern
  *
- * Count the number of patterns that can be done by the server (are full-text).
+ * Only full-text string searches are sent to the server, and any AND/OR of
+ * them.  NeoMutt already has what it needs for most match types, and does a
+ * better job (eg server doesn't support regexes).
  */
-static int do_search(const struct PatternList *search, bool allpats)
+static bool search_translatable(const struct Pattern *pat)
 {
-  int rc = 0;
-  const struct Pattern *pat = NULL;
-
-  SLIST_FOREACH(pat, search, entries)
-  {
-    switch (pat->op)
+  switch (pat->op)
+  {
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+    case MUTT_PAT_SERVERSEARCH:
+      return pat->string_match;
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
     {
-      case MUTT_PAT_BODY:
-      case MUTT_PAT_HEADER:
-      case MUTT_PAT_WHOLE_MSG:
-        if (pat->string_match)
-          rc++;
-        break;
-      case MUTT_PAT_SERVERSEARCH:
-        rc++;
-        break;
-      default:
-        if (pat->child && do_search(pat->child, true))
-          rc++;
+      const struct Pattern *np = NULL;
+      SLIST_FOREACH(np, pat->child, entries)
+      {
+        if (!search_translatable(np))
+          return false;
+      }
+      return true;
     }
-
-    if (!allpats)
-      break;
+    default:
+      return false;
   }
-
-  return rc;
 }
 
 /**
  * compile_search - Convert NeoMutt pattern to IMAP search
  * @param m   Mailbox
- * @param pat Pattern to convert
+ * @param pat Pattern to convert, see search_translatable()
  * @param buf Buffer for result
  * @retval  0 Success
  * @retval -1 Failure
- *
- * Convert neomutt Pattern to IMAP SEARCH command containing only elements
- * that require full-text search (neomutt already has what it needs for most
- * match types, and does a better job (eg server doesn't support regexes).
  */
-static int compile_search(struct Mailbox *m, const struct PatternList *pat, struct Buffer *buf)
+static int compile_search(struct Mailbox *m, const struct Pattern *pat, struct Buffer *buf)
 {
-  struct Pattern *firstpat = SLIST_FIRST(pat);
-
-  if (do_search(pat, false) == 0)
-    return 0;
-
-  if (firstpat->pat_not)
+  if (pat->pat_not)
     mutt_buffer_addstr(buf, "NOT ");
 
-  if (firstpat->child)
+  if (pat->child)
   {
-    int clauses;
+    const struct Pattern *np = NULL;
+    mutt_buffer_addch(buf, '(');
 
-    clauses = do_search(firstpat->child, true);
-    if (clauses > 0)
+    SLIST_FOREACH(np, pat->child, entries)
     {
-      mutt_buffer_addch(buf, '(');
-
-      while (clauses)
-      {
-        if (do_search(firstpat->child, false))
-        {
-          if ((firstpat->op == MUTT_PAT_OR) && (clauses > 1))
-            mutt_buffer_addstr(buf, "OR ");
-          clauses--;
+      /* IMAP's OR takes two keys, so chain them: OR a OR b c */
+      if ((pat->op == MUTT_PAT_OR) && SLIST_NEXT(np, entries))
+        mutt_buffer_addstr(buf, "OR ");
 
-          if (compile_search(m, firstpat->child, buf) < 0)
-            return -1;
-
-          if (clauses)
-            mutt_buffer_addch(buf, ' ');
-        }
-
-        SLIST_REMOVE_HEAD(firstpat->child, entries);
-      }
+      if (compile_search(m, np, buf) < 0)
+        return -1;
 
-      mutt_buffer_addch(buf, ')');
+      if (SLIST_NEXT(np, entries))
+        mutt_buffer_addch(buf, ' ');
     }
+
+    mutt_buffer_addch(buf, ')');
   }
   else
   {
     char term[256];
     char *delim = NULL;
 
-    switch (firstpat->op)
+    switch (pat->op)
     {
       case MUTT_PAT_HEADER:
         mutt_buffer_addstr(buf, "HEADER ");
 
         /* extract header name */
-        delim = strchr(firstpat->p.str, ':');
+        delim = strchr(pat->p.str, ':');
         if (!delim)
         {
-          mutt_error(_("Header search without header name: %s"), firstpat->p.str);
+          mutt_error(_("Header search without header name: %s"), pat->p.str);
           return -1;
         }
         *delim = '\0';
-        imap_quote_string(term, sizeof(term), firstpat->p.str, false);
+        imap_quote_string(term, sizeof(term), pat->p.str, false);
         mutt_buffer_addstr(buf, term);
         mutt_buffer_addch(buf, ' ');
 
@@ -458,12 +435,12 @@ static int compile_search(struct Mailbox *m, const struct PatternList *pat, stru
         break;
       case MUTT_PAT_BODY:
         mutt_buffer_addstr(buf, "BODY ");
-        imap_quote_string(term, sizeof(term), firstpat->p.str, false);
+        imap_quote_string(term, sizeof(term), pat->p.str, false);
         mutt_buffer_addstr(buf, term);
         break;
       case MUTT_PAT_WHOLE_MSG:
         mutt_buffer_addstr(buf, "TEXT ");
-        imap_quote_string(term, sizeof(term), firstpat->p.str, false);
+        imap_quote_string(term, sizeof(term), pat->p.str, false);
         mutt_buffer_addstr(buf, term);
         break;
       case MUTT_PAT_SERVERSEARCH:
@@ -471,13 +448,12 @@ static int compile_search(struct Mailbox *m, const struct PatternList *pat, stru
         struct ImapAccountData *adata = imap_adata_get(m);
         if (!(adata->capabilities & IMAP_CAP_X_GM_EXT_1))
         {
-          mutt_error(_("Server-side custom search not supported: %s"),
-                     firstpat->p.str);
+          mutt_error(_("Server-side custom search not supported: %s"), pat->p.str);
           return -1;
         }
       }
         mutt_buffer_addstr(buf, "X-GM-RAW ");
-        imap_quote_string(term, sizeof(term), firstpat->p.str, false);
+        imap_quote_string(term, sizeof(term), pat->p.str, false);
         mutt_buffer_addstr(buf, term);
         break;
     }
@@ -486,6 +462,138 @@ static int compile_search(struct Mailbox *m, const struct PatternList *pat, stru
   return 0;
 }
 
+/**
+ * search_uid_cmp - Compare two UIDs - Implements ::sort_t
+ */
+static int search_uid_cmp(const void *a, const void *b)
+{
+  const unsigned int ua = *(const unsigned int *) a;
+  const unsigned int ub = *(const unsigned int *) b;
+  return (ua > ub) - (ua < ub);
+}
+
+/**
+ * search_find - Find the results of a server-side search
+ * @param mdata Imap Mailbox data
+ * @param pat   Pattern that was searched for
+ * @retval ptr  Search results
+ * @retval NULL The Pattern hasn't been searched for
+ */
+static struct ImapSearch *search_find(struct ImapMboxData *mdata,
+                                      const struct Pattern *pat)
+{
+  for (size_t i = 0; i < mdata->num_searches; i++)
+  {
+    if (mdata->searches[i].pat == pat)
+      return &mdata->searches[i];
+  }
+
+  return NULL;
+}
+
+/**
+ * search_server - Ask the server which emails match part of a Pattern
+ * @param m   Mailbox
+ * @param pat Pattern, see search_translatable()
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * The UIDs of the matching emails are kept in the Mailbox's search results,
+ * replacing any earlier results for the same Pattern.
+ */
+static int search_server(struct Mailbox *m, const struct Pattern *pat)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  struct ImapSearch result = { pat, NULL, 0, 0 };
+  struct Buffer buf;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    result.uid_max = MAX(result.uid_max, imap_edata_get(e)->uid);
+  }
+  result.uids = mutt_mem_calloc(MAX(m->msg_count, 1), sizeof(unsigned int));
+
+  mutt_buffer_init(&buf);
+  if (adata->capabilities & IMAP_CAP_ESEARCH)
+    mutt_buffer_addstr(&buf, "UID SEARCH RETURN (ALL) ");
+  else
+    mutt_buffer_addstr(&buf, "UID SEARCH ");
+
+  /* The response handlers add the matching UIDs to the result */
+  int rc = compile_search(m, pat, &buf);
+  if (rc == 0)
+  {
+    mdata->searching = &result;
+    if (imap_exec(adata, buf.data, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
+      rc = -1;
+    mdata->searching = NULL;
+  }
+  FREE(&buf.data);
+
+  if (rc < 0)
+  {
+    FREE(&result.uids);
+    return -1;
+  }
+
+  if (result.num_uids > 1)
+    qsort(result.uids, result.num_uids, sizeof(unsigned int), search_uid_cmp);
+
+  struct ImapSearch *is = search_find(mdata, pat);
+  if (is)
+  {
+    FREE(&is->uids);
+  }
+  else
+  {
+    mutt_mem_realloc(&mdata->searches, (mdata->num_searches + 1) * sizeof(struct ImapSearch));
+    is = &mdata->searches[mdata->num_searches++];
+  }
+
+  *is = result;
+  return 0;
+}
+
+/**
+ * search_plan - Let the server evaluate the parts of a Pattern that it can
+ * @param m   Mailbox
+ * @param pat Pattern
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Each largest subtree that the server can evaluate is sent as one search and
+ * marked, see imap_search_matched().  The rest is matched locally, and only
+ * asks about the marked parts for the emails that get that far.
+ */
+static int search_plan(struct Mailbox *m, struct Pattern *pat)
+{
+  pat->server_search = false;
+
+  if (search_translatable(pat))
+  {
+    if (search_server(m, pat) < 0)
+      return -1;
+    pat->server_search = true;
+    return 0;
+  }
+
+  if (!pat->child)
+    return 0;
+
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, pat->child, entries)
+  {
+    if (search_plan(m, np) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
 /**
  * longest_common_prefix - Find longest prefix common to two strings
  * @param dest  Destination buffer
@@ -795,7 +903,9 @@ void imap_expunge_mailbox(struct Mailbox *m)
   struct Email *e = NULL;
 
 #ifdef USE_HCACHE
-  mdata->hcache = imap_hcache_open(adata, mdata);
+  const bool close_hc = !mdata->hcache;
+  if (close_hc)
+    mdata->hcache = imap_hcache_open(adata, mdata);
 #endif
 
   for (int i = 0; i < m->msg_count; i++)
@@ -843,7 +953,8 @@ void imap_expunge_mailbox(struct Mailbox *m)
   }
 
 #ifdef USE_HCACHE
-  imap_hcache_close(mdata);
+  if (close_hc)
+    imap_hcache_close(mdata);
 #endif
 
   mailbox_changed(m, NT_MAILBOX_UPDATE);
@@ -1361,37 +1472,77 @@ int imap_mailbox_status(struct Mailbox *m, bool queue)
  * @param pat Pattern to match
  * @retval  0 Success
  * @retval -1 Failure
+ *
+ * The server is asked about the parts of the Pattern it can evaluate, see
+ * search_plan().  The Pattern must then be matched locally, as usual.
  */
-int imap_search(struct Mailbox *m, const struct PatternList *pat)
+int imap_search(struct Mailbox *m, struct PatternList *pat)
 {
-  struct Buffer buf;
-  struct ImapAccountData *adata = imap_adata_get(m);
-  for (int i = 0; i < m->msg_count; i++)
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata)
+    return -1;
+
+  imap_search_reset(mdata);
+
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, pat, entries)
   {
-    struct Email *e = m->emails[i];
-    if (!e)
-      break;
-    e->matched = false;
+    if (search_plan(m, np) < 0)
+      return -1;
   }
 
-  if (do_search(pat, true) == 0)
-    return 0;
+  return 0;
+}
 
-  mutt_buffer_init(&buf);
-  mutt_buffer_addstr(&buf, "UID SEARCH ");
-  if (compile_search(m, pat, &buf) < 0)
-  {
-    FREE(&buf.data);
+/**
+ * imap_search_matched - Did the server find that an Email matches a Pattern?
+ * @param m   Mailbox
+ * @param pat Pattern, marked by imap_search()
+ * @param e   Email
+ * @retval  1 Email matches
+ * @retval  0 Email doesn't match
+ * @retval -1 The server couldn't be asked
+ *
+ * If the results of the search have been forgotten, or the Email arrived after
+ * the search, the server is asked again.
+ */
+int imap_search_matched(struct Mailbox *m, const struct Pattern *pat, struct Email *e)
+{
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  struct ImapEmailData *edata = imap_edata_get(e);
+  if (!mdata || !edata || mdata->searching)
     return -1;
-  }
-  if (imap_exec(adata, buf.data, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
+
+  const struct ImapSearch *is = search_find(mdata, pat);
+  if (!is || (edata->uid > is->uid_max))
   {
-    FREE(&buf.data);
-    return -1;
+    if (search_server(m, pat) < 0)
+      return -1;
+    is = search_find(mdata, pat);
+    if (!is || (edata->uid > is->uid_max))
+      return -1;
   }
 
-  FREE(&buf.data);
-  return 0;
+  return bsearch(&edata->uid, is->uids, is->num_uids, sizeof(unsigned int),
+                 search_uid_cmp) != NULL;
+}
+
+/**
+ * imap_search_reset - Forget the results of the last search
+ * @param mdata Imap Mailbox data
+ *
+ * The server is asked again the next time the results are needed, see
+ * imap_search_matched().
+ */
+void imap_search_reset(struct ImapMboxData *mdata)
+{
+  if (!mdata)
+    return;
+
+  for (size_t i = 0; i < mdata->num_searches; i++)
+    FREE(&mdata->searches[i].uids);
+  FREE(&mdata->searches);
+  mdata->num_searches = 0;
 }
 
 /**
@@ -2606,6 +2757,8 @@ struct MxOps MxImapOps = {
   .msg_close        = imap_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = imap_msg_save_hcache,
+  .hcache_begin     = imap_hcache_begin,
+  .hcache_commit    = imap_hcache_commit,
   .tags_edit        = imap_tags_edit,
   .tags_commit      = imap_tags_commit,
   .path_probe       = imap_path_probe,
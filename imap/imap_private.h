@@ -39,6 +39,7 @@ struct ConnAccount;
 struct Email;
 struct Mailbox;
 struct Message;
+struct Pattern;
 struct Progress;
 
 #define IMAP_PORT     143  ///< Default port for IMAP
@@ -137,8 +138,9 @@ typedef uint32_t ImapCapFlags;              ///< Flags, e.g. #IMAP_CAP_IMAP4
 #define IMAP_CAP_LIST_EXTENDED    (1 << 16) ///< RFC5258: IMAP4 LIST Command Extensions
 #define IMAP_CAP_COMPRESS         (1 << 17) ///< RFC4978: COMPRESS=DEFLATE
 #define IMAP_CAP_X_GM_EXT_1       (1 << 18) ///< https://developers.google.com/gmail/imap/imap-extensions
+#define IMAP_CAP_ESEARCH          (1 << 19) ///< RFC4731: IMAP4 Extension to SEARCH Command
 
-#define IMAP_CAP_ALL             ((1 << 19) - 1)
+#define IMAP_CAP_ALL             ((1 << 20) - 1)
 
 /**
  * struct ImapList - Items in an IMAP browser
@@ -207,6 +209,17 @@ struct ImapAccountData
   struct Account *account;     ///< Parent Account
 };
 
+/**
+ * struct ImapSearch - Result of a server-side search for part of a Pattern
+ */
+struct ImapSearch
+{
+  const struct Pattern *pat; ///< Part of a Pattern that the server evaluated
+  unsigned int *uids;        ///< UIDs of the matching emails, sorted
+  size_t num_uids;           ///< Number of matching emails
+  unsigned int uid_max;      ///< Highest UID that was searched
+};
+
 /**
  * struct ImapMboxData - IMAP-specific Mailbox data - @extends Mailbox
  *
@@ -239,6 +252,11 @@ struct ImapMboxData
   struct BodyCache *bcache;
 
   header_cache_t *hcache;
+
+  // Results of the last imap_search()
+  struct ImapSearch *searches; ///< Array of search results
+  size_t num_searches;         ///< Number of search results
+  struct ImapSearch *searching; ///< Search whose results are being read
 };
 
 /**
@@ -266,6 +284,7 @@ int imap_open_connection(struct ImapAccountData *adata);
 void imap_close_connection(struct ImapAccountData *adata);
 int imap_read_literal(FILE *fp, struct ImapAccountData *adata, unsigned long bytes, struct Progress *pbar);
 void imap_expunge_mailbox(struct Mailbox *m);
+void imap_search_reset(struct ImapMboxData *mdata);
 int imap_login(struct ImapAccountData *adata);
 int imap_sync_message_for_copy(struct Mailbox *m, struct Email *e, struct Buffer *cmd, enum QuadOption *err_continue);
 bool imap_has_flag(struct ListHead *flag_list, const char *flag);
@@ -296,6 +315,8 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno);
 int imap_msg_close(struct Mailbox *m, struct Message *msg);
 int imap_msg_commit(struct Mailbox *m, struct Message *msg);
 int imap_msg_save_hcache(struct Mailbox *m, struct Email *e);
+int imap_hcache_begin(struct Mailbox *m);
+int imap_hcache_commit(struct Mailbox *m);
 
 /* util.c */
 struct ImapAccountData *imap_adata_get(struct Mailbox *m);
@@ -305,6 +326,7 @@ header_cache_t *imap_hcache_open(struct ImapAccountData *adata, struct ImapMboxD
 void imap_hcache_close(struct ImapMboxData *mdata);
 struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid);
 int imap_hcache_put(struct ImapMboxData *mdata, struct Email *e);
+int imap_hcache_put_batch(struct ImapMboxData *mdata, struct Email **emails, int num);
 int imap_hcache_del(struct ImapMboxData *mdata, unsigned int uid);
 int imap_hcache_store_uid_seqset(struct ImapMboxData *mdata);
 int imap_hcache_clear_uid_seqset(struct ImapMboxData *mdata);
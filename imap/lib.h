@@ -59,7 +59,9 @@
 struct BrowserState;
 struct Buffer;
 struct ConnAccount;
+struct Email;
 struct EmailList;
+struct Pattern;
 struct PatternList;
 struct stat;
 
@@ -94,7 +96,8 @@ int imap_delete_mailbox(struct Mailbox *m, char *path);
 int imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close);
 int imap_path_status(const char *path, bool queue);
 int imap_mailbox_status(struct Mailbox *m, bool queue);
-int imap_search(struct Mailbox *m, const struct PatternList *pat);
+int imap_search(struct Mailbox *m, struct PatternList *pat);
+int imap_search_matched(struct Mailbox *m, const struct Pattern *pat, struct Email *e);
 int imap_subscribe(char *path, bool subscribe);
 int imap_complete(char *buf, size_t buflen, const char *path);
 int imap_fast_trash(struct Mailbox *m, char *dest);
@@ -704,7 +704,13 @@ static void set_changed_flag(struct Mailbox *m, struct Email *e, int local_chang
 
   /* Local changes have priority */
   if (local_changes == 0)
+  {
     mutt_set_flag(m, e, flag_name, new_hd_flag);
+    /* The limit has to be applied to the server's flags again, and the
+     * server's searches may depend on them */
+    e->limit_checked = false;
+    imap_search_reset(imap_mdata_get(m));
+  }
 }
 
 #ifdef USE_HCACHE
@@ -747,13 +753,22 @@ static int read_headers_normal_eval_cache(struct ImapAccountData *adata,
 
   imap_cmd_start(adata, buf);
 
+  /* The flag updates are written to the cache in one batch */
+  const bool batch = !eval_condstore && store_flag_updates;
+  if (batch)
+    mutt_hcache_begin(mdata->hcache);
+
   int rc = IMAP_RES_CONTINUE;
   int mfhrc = 0;
+  int retval = 0;
   struct ImapHeader h;
   for (int msgno = 1; rc == IMAP_RES_CONTINUE; msgno++)
   {
     if (SigInt && query_abort_header_download(adata))
-      return -1;
+    {
+      retval = -1;
+      break;
+    }
 
     mutt_progress_update(&progress, msgno, -1);
 
@@ -846,10 +861,16 @@ static int read_headers_normal_eval_cache(struct ImapAccountData *adata,
     imap_edata_free((void **) &h.edata);
 
     if ((mfhrc < -1) || ((rc != IMAP_RES_CONTINUE) && (rc != IMAP_RES_OK)))
-      return -1;
+    {
+      retval = -1;
+      break;
+    }
   }
 
-  return 0;
+  if (batch)
+    mutt_hcache_commit(mdata->hcache);
+
+  return retval;
 }
 
 /**
@@ -995,7 +1016,6 @@ static int read_headers_condstore_qresync_updates(struct ImapAccountData *adata,
   /* VANISHED handling: we need to empty out the messages */
   if (mdata->reopen & IMAP_EXPUNGE_PENDING)
   {
-    imap_hcache_close(mdata);
     imap_expunge_mailbox(m);
 
     /* undo expunge count updates.
@@ -1008,7 +1028,6 @@ static int read_headers_condstore_qresync_updates(struct ImapAccountData *adata,
     m->msg_flagged = 0;
     m->changed = 0;
 
-    mdata->hcache = imap_hcache_open(adata, mdata);
     mdata->reopen &= ~IMAP_EXPUNGE_PENDING;
   }
 
@@ -1047,6 +1066,9 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   struct ImapAccountData *adata = imap_adata_get(m);
   struct ImapMboxData *mdata = imap_mdata_get(m);
   int idx = m->msg_count;
+#ifdef USE_HCACHE
+  int hc_queued = idx; /* first Email that isn't in the header cache yet */
+#endif
 
   if (!adata || (adata->mailbox != m))
     return -1;
@@ -1205,10 +1227,6 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
         e->content->length = h.content_length;
         mailbox_size_add(m, e);
 
-#ifdef USE_HCACHE
-        imap_hcache_put(mdata, e);
-#endif /* USE_HCACHE */
-
         m->msg_count++;
 
         h.edata = NULL;
@@ -1221,6 +1239,13 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
         goto bail;
     }
 
+#ifdef USE_HCACHE
+    /* Cache the headers once the server's response is complete, in one batch,
+     * rather than committing each one while the response is being read */
+    imap_hcache_put_batch(mdata, m->emails + hc_queued, idx - hc_queued);
+    hc_queued = idx;
+#endif
+
     /* In case we get new mail while fetching the headers. */
     if (mdata->reopen & IMAP_NEWMAIL_PENDING)
     {
@@ -1248,6 +1273,9 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   retval = 0;
 
 bail:
+#ifdef USE_HCACHE
+  imap_hcache_put_batch(mdata, m->emails + hc_queued, idx - hc_queued);
+#endif
   mutt_buffer_pool_release(&hdr_list);
   mutt_buffer_pool_release(&buf);
   mutt_buffer_pool_release(&tempfile);
@@ -1289,6 +1317,7 @@ int imap_read_headers(struct Mailbox *m, unsigned int msn_begin,
   unsigned long long *pmodseq = NULL;
   unsigned long long hc_modseq = 0;
   char *uid_seqset = NULL;
+  bool close_hc = true;
 #endif /* USE_HCACHE */
 
   struct ImapAccountData *adata = imap_adata_get(m);
@@ -1307,12 +1336,15 @@ int imap_read_headers(struct Mailbox *m, unsigned int msn_begin,
   mdata->new_mail_count = 0;
 
 #ifdef USE_HCACHE
-  mdata->hcache = imap_hcache_open(adata, mdata);
+  if (mdata->hcache)
+    close_hc = false;
+  else
+    mdata->hcache = imap_hcache_open(adata, mdata);
 
   if (mdata->hcache && initial_download)
   {
-    uid_validity = mutt_hcache_fetch_raw(mdata->hcache, "/UIDVALIDITY", 12);
-    puid_next = mutt_hcache_fetch_raw(mdata->hcache, "/UIDNEXT", 8);
+    uid_validity = mutt_hcache_fetch_raw(mdata->hcache, "/UIDVALIDITY", 12, NULL);
+    puid_next = mutt_hcache_fetch_raw(mdata->hcache, "/UIDNEXT", 8, NULL);
     if (puid_next)
     {
       uid_next = *(unsigned int *) puid_next;
@@ -1333,7 +1365,7 @@ int imap_read_headers(struct Mailbox *m, unsigned int msn_begin,
     if (uid_validity && uid_next && (*(unsigned int *) uid_validity == mdata->uid_validity))
     {
       evalhc = true;
-      pmodseq = mutt_hcache_fetch_raw(mdata->hcache, "/MODSEQ", 7);
+      pmodseq = mutt_hcache_fetch_raw(mdata->hcache, "/MODSEQ", 7, NULL);
       if (pmodseq)
       {
         hc_modseq = *pmodseq;
@@ -1441,7 +1473,8 @@ int imap_read_headers(struct Mailbox *m, unsigned int msn_begin,
 
 bail:
 #ifdef USE_HCACHE
-  imap_hcache_close(mdata);
+  if (close_hc)
+    imap_hcache_close(mdata);
   FREE(&uid_seqset);
 #endif /* USE_HCACHE */
 
@@ -1819,10 +1852,21 @@ char *imap_set_flags(struct Mailbox *m, struct Email *e, char *s, bool *server_c
   struct ImapEmailData *edata = e->edata;
   newh.edata = edata;
 
+  char *old_keywords = mutt_str_strdup(edata->flags_remote);
   mutt_debug(LL_DEBUG2, "parsing FLAGS\n");
   s = msg_parse_flags(&newh, s);
   if (!s)
+  {
+    FREE(&old_keywords);
     return NULL;
+  }
+
+  if (mutt_str_strcmp(old_keywords, edata->flags_remote) != 0)
+  {
+    e->limit_checked = false;
+    imap_search_reset(imap_mdata_get(m));
+  }
+  FREE(&old_keywords);
 
   /* Update tags system */
   /* We take a copy of the tags so we can split the string */
@@ -2024,6 +2068,7 @@ parsemsg:
   read = e->read;
   newenv = mutt_rfc822_read_header(msg->fp, e, false, false);
   mutt_env_merge(e->env, &newenv);
+  FREE(&e->pattern_memo);
 
   /* see above. We want the new status in e->read, so we unset it manually
    * and let mutt_set_flag set it correctly, updating context. */
@@ -2110,3 +2155,40 @@ int imap_msg_save_hcache(struct Mailbox *m, struct Email *e)
 #endif
   return rc;
 }
+
+/**
+ * imap_hcache_begin - Start a batch of header cache saves - Implements MxOps::hcache_begin()
+ */
+int imap_hcache_begin(struct Mailbox *m)
+{
+#ifdef USE_HCACHE
+  struct ImapAccountData *adata = imap_adata_get(m);
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata || !adata || mdata->hcache)
+    return -1;
+
+  mdata->hcache = imap_hcache_open(adata, mdata);
+  if (!mdata->hcache)
+    return -1;
+
+  mutt_hcache_begin(mdata->hcache);
+#endif
+  return 0;
+}
+
+/**
+ * imap_hcache_commit - Finish a batch of header cache saves - Implements MxOps::hcache_commit()
+ */
+int imap_hcache_commit(struct Mailbox *m)
+{
+  int rc = 0;
+#ifdef USE_HCACHE
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata || !mdata->hcache)
+    return -1;
+
+  rc = mutt_hcache_commit(mdata->hcache);
+  imap_hcache_close(mdata);
+#endif
+  return rc;
+}
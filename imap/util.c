@@ -191,9 +191,9 @@ struct ImapMboxData *imap_mdata_new(struct ImapAccountData *adata, const char *n
   header_cache_t *hc = imap_hcache_open(adata, mdata);
   if (hc)
   {
-    void *uidvalidity = mutt_hcache_fetch_raw(hc, "/UIDVALIDITY", 12);
-    void *uidnext = mutt_hcache_fetch_raw(hc, "/UIDNEXT", 8);
-    unsigned long long *modseq = mutt_hcache_fetch_raw(hc, "/MODSEQ", 7);
+    void *uidvalidity = mutt_hcache_fetch_raw(hc, "/UIDVALIDITY", 12, NULL);
+    void *uidnext = mutt_hcache_fetch_raw(hc, "/UIDNEXT", 8, NULL);
+    unsigned long long *modseq = mutt_hcache_fetch_raw(hc, "/MODSEQ", 7, NULL);
     if (uidvalidity)
     {
       mdata->uid_validity = *(unsigned int *) uidvalidity;
@@ -223,6 +223,7 @@ void imap_mdata_cache_reset(struct ImapMboxData *mdata)
   mdata->msn_index_size = 0;
   mdata->max_msn = 0;
   mutt_bcache_close(&mdata->bcache);
+  imap_search_reset(mdata);
 }
 
 /**
@@ -499,21 +500,10 @@ struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid)
     return NULL;
 
   char key[16];
-  struct Email *e = NULL;
 
   sprintf(key, "/%u", uid);
-  void *uv = mutt_hcache_fetch(mdata->hcache, key, mutt_str_strlen(key));
-  if (uv)
-  {
-    const size_t *const uid_validity = uv;
-    if (*uid_validity == mdata->uid_validity)
-      e = mutt_hcache_restore(uv);
-    else
-      mutt_debug(LL_DEBUG3, "hcache uidvalidity mismatch: %zu\n", *uid_validity);
-    mutt_hcache_free(mdata->hcache, &uv);
-  }
-
-  return e;
+  return mutt_hcache_fetch_email(mdata->hcache, key, mutt_str_strlen(key),
+                                 &mdata->uid_validity);
 }
 
 /**
@@ -534,6 +524,39 @@ int imap_hcache_put(struct ImapMboxData *mdata, struct Email *e)
   return mutt_hcache_store(mdata->hcache, key, mutt_str_strlen(key), e, mdata->uid_validity);
 }
 
+/**
+ * imap_hcache_put_batch - Add several entries to the header cache
+ * @param mdata  Imap Mailbox data
+ * @param emails Array of Emails
+ * @param num    Number of Emails
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * The entries are written in a single batch, see mutt_hcache_store_n().
+ */
+int imap_hcache_put_batch(struct ImapMboxData *mdata, struct Email **emails, int num)
+{
+  if (!mdata->hcache)
+    return -1;
+  if (num <= 0)
+    return 0;
+
+  char *keybuf = mutt_mem_calloc(num, 16);
+  const char **keys = mutt_mem_calloc(num, sizeof(char *));
+
+  for (int i = 0; i < num; i++)
+  {
+    keys[i] = keybuf + (i * 16);
+    sprintf(keybuf + (i * 16), "/%u", imap_edata_get(emails[i])->uid);
+  }
+
+  int rc = mutt_hcache_store_n(mdata->hcache, keys, NULL, emails, num, mdata->uid_validity);
+
+  FREE(&keys);
+  FREE(&keybuf);
+  return (rc == 0) ? 0 : -1;
+}
+
 /**
  * imap_hcache_del - Delete an item from the header cache
  * @param mdata Imap Mailbox data
@@ -599,7 +622,7 @@ char *imap_hcache_get_uid_seqset(struct ImapMboxData *mdata)
   if (!mdata->hcache)
     return NULL;
 
-  char *hc_seqset = mutt_hcache_fetch_raw(mdata->hcache, "/UIDSEQSET", 10);
+  char *hc_seqset = mutt_hcache_fetch_raw(mdata->hcache, "/UIDSEQSET", 10, NULL);
   char *seqset = mutt_str_strdup(hc_seqset);
   mutt_hcache_free(mdata->hcache, (void **) &hc_seqset);
   mutt_debug(LL_DEBUG3, "Retrieved /UIDSEQSET %s\n", NONULL(seqset));
@@ -154,6 +154,57 @@ typedef uint8_t CheckFlags;       ///< Flags, e.g. #CHECK_IN_MAILBOX
 #define CHECK_ATTACH     (1 << 4) ///< Is the user in message-attach mode?
 // clang-format on
 
+static unsigned int IndexLineGen = 1; ///< Generation of the cached lines of the index
+
+/**
+ * index_invalidate_lines - Forget the cached lines of the index
+ *
+ * Each line is made again the next time it's displayed.
+ */
+void index_invalidate_lines(void)
+{
+  IndexLineGen++;
+}
+
+/**
+ * op_is_motion - Does a function only move the cursor?
+ * @param op Operation, e.g. OP_NEXT_PAGE
+ * @retval true The Emails are unchanged, so the cached index lines are good
+ */
+static bool op_is_motion(int op)
+{
+  switch (op)
+  {
+    case OP_BOTTOM_PAGE:
+    case OP_CURRENT_BOTTOM:
+    case OP_CURRENT_MIDDLE:
+    case OP_CURRENT_TOP:
+    case OP_FIRST_ENTRY:
+    case OP_HALF_DOWN:
+    case OP_HALF_UP:
+    case OP_LAST_ENTRY:
+    case OP_MAIN_NEXT_SUBTHREAD:
+    case OP_MAIN_NEXT_THREAD:
+    case OP_MAIN_NEXT_UNDELETED:
+    case OP_MAIN_PARENT_MESSAGE:
+    case OP_MAIN_PREV_SUBTHREAD:
+    case OP_MAIN_PREV_THREAD:
+    case OP_MAIN_PREV_UNDELETED:
+    case OP_MAIN_ROOT_MESSAGE:
+    case OP_MIDDLE_PAGE:
+    case OP_NEXT_ENTRY:
+    case OP_NEXT_LINE:
+    case OP_NEXT_PAGE:
+    case OP_PREV_ENTRY:
+    case OP_PREV_LINE:
+    case OP_PREV_PAGE:
+    case OP_TOP_PAGE:
+      return true;
+    default:
+      return false;
+  }
+}
+
 /**
  * get_cur_email - Get the currently-selected Email
  * @param ctx  Context
@@ -480,6 +531,28 @@ static void resort_index(struct Context *ctx, struct Menu *menu)
   menu->redraw |= REDRAW_INDEX | REDRAW_STATUS;
 }
 
+/**
+ * limit_check - Does an Email belong in the limited view?
+ * @param ctx Mailbox
+ * @param e   Email
+ * @retval true The Email matches the limit
+ *
+ * The limit is only applied once to each Email, so checking for new mail only
+ * costs as much as the new mail.  A backend that changes an Email's flags
+ * clears Email::limit_checked, so that the limit is applied again.  As with
+ * local changes to the flags, an Email that the user changes stays where it is.
+ */
+static bool limit_check(struct Context *ctx, struct Email *e)
+{
+  if (!e->limit_checked)
+  {
+    e->limited = mutt_pattern_exec(SLIST_FIRST(ctx->limit_pattern),
+                                   MUTT_MATCH_FULL_ADDRESS, ctx->mailbox, e, NULL);
+    e->limit_checked = true;
+  }
+  return e->limited;
+}
+
 /**
  * update_index_threaded - Update the index (if threaded)
  * @param ctx      Mailbox
@@ -506,23 +579,16 @@ static void update_index_threaded(struct Context *ctx, int check, int oldcount)
 
   if (ctx->pattern)
   {
-    for (int i = (check == MUTT_REOPENED) ? 0 : oldcount; i < ctx->mailbox->msg_count; i++)
+    /* Only new Emails and ones whose flags have changed are matched again */
+    for (int i = 0; i < ctx->mailbox->msg_count; i++)
     {
-      struct Email *e = NULL;
-
-      if ((check != MUTT_REOPENED) && oldcount)
-        e = save_new[i - oldcount];
-      else
-        e = ctx->mailbox->emails[i];
+      struct Email *e = ctx->mailbox->emails[i];
+      if (!e)
+        break;
 
-      if (mutt_pattern_exec(SLIST_FIRST(ctx->limit_pattern),
-                            MUTT_MATCH_FULL_ADDRESS, ctx->mailbox, e, NULL))
-      {
-        /* vnum will get properly set by mutt_set_vnum(), which
-         * is called by mutt_sort_headers() just below. */
-        e->vnum = 1;
-        e->limited = true;
-      }
+      /* vnum will get properly set by mutt_set_vnum(), which
+       * is called by mutt_sort_headers() just below. */
+      e->vnum = limit_check(ctx, e) ? 1 : -1;
     }
     /* Need a second sort to set virtual numbers and redraw the tree */
     mutt_sort_headers(ctx, false);
@@ -573,29 +639,27 @@ static void update_index_unthreaded(struct Context *ctx, int check, int oldcount
    * they will be visible in the limited view */
   if (ctx->pattern)
   {
+    /* The view is rebuilt, but only new Emails and ones whose flags have
+     * changed are matched again */
+    ctx->mailbox->vcount = 0;
+    ctx->vsize = 0;
     int padding = mx_msg_padding_size(ctx->mailbox);
-    for (int i = (check == MUTT_REOPENED) ? 0 : oldcount; i < ctx->mailbox->msg_count; i++)
+    for (int i = 0; i < ctx->mailbox->msg_count; i++)
     {
-      if (i == 0)
-      {
-        ctx->mailbox->vcount = 0;
-        ctx->vsize = 0;
-      }
-
       struct Email *e = ctx->mailbox->emails[i];
       if (!e)
         break;
-      if (mutt_pattern_exec(SLIST_FIRST(ctx->limit_pattern),
-                            MUTT_MATCH_FULL_ADDRESS, ctx->mailbox, e, NULL))
+      if (limit_check(ctx, e))
       {
         assert(ctx->mailbox->vcount < ctx->mailbox->msg_count);
         e->vnum = ctx->mailbox->vcount;
         ctx->mailbox->v2r[ctx->mailbox->vcount] = i;
-        e->limited = true;
         ctx->mailbox->vcount++;
         struct Body *b = e->content;
         ctx->vsize += b->length + b->offset - b->hdr_offset + padding;
       }
+      else
+        e->vnum = -1;
     }
   }
 
@@ -625,6 +689,18 @@ void update_index(struct Menu *menu, struct Context *ctx, int check, int oldcoun
       oldcount = 0; /* invalid message number! */
   }
 
+  /* Any of the Emails may have changed, so the limit is applied to them all */
+  if (check == MUTT_REOPENED)
+  {
+    for (int i = 0; i < ctx->mailbox->msg_count; i++)
+    {
+      struct Email *e = ctx->mailbox->emails[i];
+      if (!e)
+        break;
+      e->limit_checked = false;
+    }
+  }
+
   if ((C_Sort & SORT_MASK) == SORT_THREADS)
     update_index_threaded(ctx, check, oldcount);
   else
@@ -837,6 +913,9 @@ void index_make_entry(char *buf, size_t buflen, struct Menu *menu, int line)
   MuttFormatFlags flags = MUTT_FORMAT_ARROWCURSOR | MUTT_FORMAT_INDEX;
   struct MuttThread *tmp = NULL;
 
+  if ((C_Sort & SORT_MASK) == SORT_THREADS)
+    mutt_draw_thread_tree(e);
+
   if (((C_Sort & SORT_MASK) == SORT_THREADS) && e->tree)
   {
     flags |= MUTT_FORMAT_TREE; /* display the thread tree */
@@ -891,8 +970,21 @@ void index_make_entry(char *buf, size_t buflen, struct Menu *menu, int line)
     }
   }
 
-  mutt_make_string_flags(buf, buflen, menu->win_index->state.cols,
-                         NONULL(C_IndexFormat), Context, Context->mailbox, e, flags);
+  const int cols = menu->win_index->state.cols;
+  if (e->index_line && (e->index_line_gen == IndexLineGen) &&
+      (e->index_line_cols == cols) && (e->index_line_flags == flags))
+  {
+    mutt_str_strfcpy(buf, e->index_line, buflen);
+    return;
+  }
+
+  mutt_make_string_flags(buf, buflen, cols, NONULL(C_IndexFormat), Context,
+                         Context->mailbox, e, flags);
+
+  mutt_str_replace(&e->index_line, buf);
+  e->index_line_gen = IndexLineGen;
+  e->index_line_cols = cols;
+  e->index_line_flags = flags;
 }
 
 /**
@@ -1169,6 +1261,10 @@ int mutt_index_menu(struct MuttWindow *dlg)
 
   while (true)
   {
+    /* Anything but moving the cursor may have changed the Emails */
+    if (!op_is_motion(op))
+      index_invalidate_lines();
+
     /* Clear the tag prefix unless we just started it.  Don't clear
      * the prefix on a timeout (op==-2), but do clear on an abort (op==-1) */
     if (tag && (op != OP_TAG_PREFIX) && (op != OP_TAG_PREFIX_COND) && (op != -2))
@@ -1250,6 +1346,7 @@ int mutt_index_menu(struct MuttWindow *dlg)
 
         /* avoid the message being overwritten by mailbox */
         do_mailbox_notify = false;
+        index_invalidate_lines();
 
         if (Context && Context->mailbox)
         {
@@ -4009,6 +4106,29 @@ int mutt_reply_observer(struct NotifyCallback *nc)
   return 0;
 }
 
+/**
+ * index_line_observer - Listen for changes affecting the cached lines of the index - Implements ::observer_t
+ */
+static int index_line_observer(struct NotifyCallback *nc)
+{
+  if (!nc)
+    return -1;
+
+  switch (nc->event_type)
+  {
+    case NT_COLOR:
+    case NT_CONFIG:
+    case NT_CONTEXT:
+    case NT_MAILBOX:
+      index_invalidate_lines();
+      break;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
 /**
  * index_pager_init - Allocate the Windows for the Index/Pager
  * @retval ptr Dialog containing nested Windows
@@ -4098,6 +4218,7 @@ struct MuttWindow *index_pager_init(void)
   }
 
   notify_observer_add(NeoMutt->notify, mutt_sb_observer, win_sidebar);
+  notify_observer_add(NeoMutt->notify, index_line_observer, dlg);
 
   return dlg;
 }
@@ -4111,6 +4232,8 @@ void index_pager_shutdown(struct MuttWindow *dlg)
   if (!dlg)
     return;
 
+  notify_observer_remove(NeoMutt->notify, index_line_observer, dlg);
+
   struct MuttWindow *win_sidebar = mutt_window_find(dlg, WT_SIDEBAR);
   if (!win_sidebar)
     return;
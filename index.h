@@ -44,6 +44,7 @@ extern bool  C_UncollapseJump;
 extern bool  C_UncollapseNew;
 
 int  index_color(int line);
+void index_invalidate_lines(void);
 void index_make_entry(char *buf, size_t buflen, struct Menu *menu, int line);
 void mutt_draw_statusline(int cols, const char *buf, size_t buflen);
 int  mutt_index_menu(struct MuttWindow *dlg);
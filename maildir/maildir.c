@@ -670,11 +670,17 @@ static int maildir_msg_save_hcache(struct Mailbox *m, struct Email *e)
 {
   int rc = 0;
 #ifdef USE_HCACHE
-  header_cache_t *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  header_cache_t *hc = NULL;
+  if (mdata && mdata->hcache)
+    hc = mdata->hcache;
+  else
+    hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
   char *key = e->path + 3;
   int keylen = maildir_hcache_keylen(key);
   rc = mutt_hcache_store(hc, key, keylen, e, 0);
-  mutt_hcache_close(hc);
+  if (!mdata || (hc != mdata->hcache))
+    mutt_hcache_close(hc);
 #endif
   return rc;
 }
@@ -722,6 +728,8 @@ struct MxOps MxMaildirOps = {
   .msg_close        = mh_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = maildir_msg_save_hcache,
+  .hcache_begin     = mh_hcache_begin,
+  .hcache_commit    = mh_hcache_commit,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = maildir_path_probe,
@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <time.h>
+#include "hcache/lib.h"
 
 struct Account;
 struct Buffer;
@@ -43,6 +44,7 @@ struct MaildirMboxData
 {
   struct timespec mtime_cur;
   mode_t mh_umask;
+  header_cache_t *hcache; ///< Header cache held open by mh_hcache_begin()
 };
 
 /**
@@ -79,6 +81,8 @@ int             maildir_mbox_check (struct Mailbox *m, int *index_hint);
 int             maildir_path_canon (char *buf, size_t buflen);
 int             maildir_path_parent(char *buf, size_t buflen);
 int             maildir_path_pretty(char *buf, size_t buflen, const char *folder);
+int             mh_hcache_begin    (struct Mailbox *m);
+int             mh_hcache_commit   (struct Mailbox *m);
 int             mh_mbox_check      (struct Mailbox *m, int *index_hint);
 int             mh_mbox_close      (struct Mailbox *m);
 int             mh_mbox_sync       (struct Mailbox *m, int *index_hint);
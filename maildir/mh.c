@@ -829,6 +829,8 @@ struct MxOps MxMhOps = {
   .msg_close        = mh_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = mh_msg_save_hcache,
+  .hcache_begin     = mh_hcache_begin,
+  .hcache_commit    = mh_hcache_commit,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = mh_path_probe,
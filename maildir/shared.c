@@ -70,6 +70,8 @@ char *C_MhSeqReplied; ///< Config: MH sequence to tag replied messages
 char *C_MhSeqUnseen;  ///< Config: MH sequence for unseen messages
 
 #define INS_SORT_THRESHOLD 6
+#define MAILDIR_READAHEAD 32 ///< Number of files to open ahead of the parser
+#define MAILDIR_DIRENT_BUFSIZE (256 * 1024) ///< Size of the buffer for batched directory reads
 
 /**
  * maildir_mdata_free - Free data attached to the Mailbox
@@ -325,6 +327,112 @@ static void maildir_update_mtime(struct Mailbox *m)
     mutt_file_get_stat_timespec(&m->mtime, &st, MUTT_STAT_MTIME);
 }
 
+/**
+ * struct MaildirScan - Batched reader for the entries of a directory
+ *
+ * Where the system allows it, the directory is read using large getdents64()
+ * calls, rather than readdir()'s small ones.  This cuts down the number of
+ * round trips needed to list a big Maildir, especially on network filesystems.
+ */
+struct MaildirScan
+{
+#ifdef HAVE_GETDENTS64
+  int fd;     ///< Directory file descriptor
+  char *buf;  ///< Buffer of raw directory entries
+  size_t len; ///< Number of bytes in the buffer
+  size_t pos; ///< Offset of the next entry in the buffer
+#else
+  DIR *dirp;  ///< Directory stream
+#endif
+};
+
+/**
+ * struct MaildirDirent - A directory entry returned by md_scan_next()
+ */
+struct MaildirDirent
+{
+  const char *name;   ///< Filename (owned by the MaildirScan)
+  ino_t inode;        ///< Inode number
+  unsigned char type; ///< File type, e.g. DT_REG, or DT_UNKNOWN
+};
+
+/**
+ * md_scan_open - Start reading a directory
+ * @param scan Scan state to initialise
+ * @param path Directory to read
+ * @retval true Success
+ */
+static bool md_scan_open(struct MaildirScan *scan, const char *path)
+{
+  memset(scan, 0, sizeof(*scan));
+#ifdef HAVE_GETDENTS64
+  scan->fd = open(path, O_RDONLY | O_DIRECTORY);
+  if (scan->fd < 0)
+    return false;
+  scan->buf = mutt_mem_malloc(MAILDIR_DIRENT_BUFSIZE);
+  return true;
+#else
+  scan->dirp = opendir(path);
+  return scan->dirp;
+#endif
+}
+
+/**
+ * md_scan_next - Get the next entry from a directory
+ * @param[in]  scan Scan state
+ * @param[out] de   Directory entry
+ * @retval true  An entry was returned
+ * @retval false End of directory, or error
+ */
+static bool md_scan_next(struct MaildirScan *scan, struct MaildirDirent *de)
+{
+#ifdef HAVE_GETDENTS64
+  if (scan->pos >= scan->len)
+  {
+    ssize_t rc = getdents64(scan->fd, scan->buf, MAILDIR_DIRENT_BUFSIZE);
+    if (rc <= 0)
+      return false;
+    scan->len = rc;
+    scan->pos = 0;
+  }
+
+  struct dirent64 *d = (struct dirent64 *) (scan->buf + scan->pos);
+  scan->pos += d->d_reclen;
+  de->name = d->d_name;
+  de->inode = d->d_ino;
+  de->type = d->d_type;
+  return true;
+#else
+  struct dirent *d = readdir(scan->dirp);
+  if (!d)
+    return false;
+  de->name = d->d_name;
+  de->inode = d->d_ino;
+#ifdef _DIRENT_HAVE_D_TYPE
+  de->type = d->d_type;
+#else
+  de->type = DT_UNKNOWN;
+#endif
+  return true;
+#endif
+}
+
+/**
+ * md_scan_close - Finish reading a directory
+ * @param scan Scan state
+ */
+static void md_scan_close(struct MaildirScan *scan)
+{
+#ifdef HAVE_GETDENTS64
+  if (scan->fd >= 0)
+    close(scan->fd);
+  FREE(&scan->buf);
+#else
+  if (scan->dirp)
+    closedir(scan->dirp);
+#endif
+}
+
 /**
  * maildir_parse_dir - Read a Maildir mailbox
  * @param[in]  m        Mailbox
@@ -339,7 +447,8 @@ static void maildir_update_mtime(struct Mailbox *m)
 int maildir_parse_dir(struct Mailbox *m, struct Maildir ***last,
                       const char *subdir, int *count, struct Progress *progress)
 {
-  struct dirent *de = NULL;
+  struct MaildirScan scan;
+  struct MaildirDirent de;
   int rc = 0;
   bool is_old = false;
   struct Maildir *entry = NULL;
@@ -355,28 +464,33 @@ int maildir_parse_dir(struct Mailbox *m, struct Maildir ***last,
   else
     mutt_buffer_strcpy(buf, mailbox_path(m));
 
-  DIR *dirp = opendir(mutt_b2s(buf));
-  if (!dirp)
+  if (!md_scan_open(&scan, mutt_b2s(buf)))
   {
+    md_scan_close(&scan);
     rc = -1;
     goto cleanup;
   }
 
-  while (((de = readdir(dirp))) && (SigInt != 1))
+  while (md_scan_next(&scan, &de) && (SigInt != 1))
   {
-    if (((m->magic == MUTT_MH) && !mh_valid_message(de->d_name)) ||
-        ((m->magic == MUTT_MAILDIR) && (*de->d_name == '.')))
+    if (((m->magic == MUTT_MH) && !mh_valid_message(de.name)) ||
+        ((m->magic == MUTT_MAILDIR) && (*de.name == '.')))
     {
       continue;
     }
 
+    /* The filesystem told us the type, so we don't need to stat() it.
+     * Anything that can't be a message, e.g. a directory, is ignored. */
+    if ((de.type != DT_UNKNOWN) && (de.type != DT_REG) && (de.type != DT_LNK))
+      continue;
+
     /* FOO - really ignore the return value? */
-    mutt_debug(LL_DEBUG2, "queueing %s\n", de->d_name);
+    mutt_debug(LL_DEBUG2, "queueing %s\n", de.name);
 
     e = email_new();
     e->old = is_old;
     if (m->magic == MUTT_MAILDIR)
-      maildir_parse_flags(e, de->d_name);
+      maildir_parse_flags(e, de.name);
 
     if (count)
     {
@@ -387,20 +501,20 @@ int maildir_parse_dir(struct Mailbox *m, struct Maildir ***last,
 
     if (subdir)
     {
-      mutt_buffer_printf(buf, "%s/%s", subdir, de->d_name);
+      mutt_buffer_printf(buf, "%s/%s", subdir, de.name);
       e->path = mutt_buffer_strdup(buf);
     }
     else
-      e->path = mutt_str_strdup(de->d_name);
+      e->path = mutt_str_strdup(de.name);
 
     entry = maildir_entry_new();
     entry->email = e;
-    entry->inode = de->d_ino;
+    entry->inode = de.inode;
     **last = entry;
     *last = &entry->next;
   }
 
-  closedir(dirp);
+  md_scan_close(&scan);
 
   if (SigInt == 1)
   {
@@ -672,112 +786,223 @@ static struct Maildir *skip_duplicates(struct Maildir *p, struct Maildir **last)
   return p;
 }
 
+/**
+ * maildir_readahead - Open a message and ask the kernel to start reading it
+ * @param m  Mailbox
+ * @param md Maildir entry whose file should be read
+ * @retval ptr  Open file handle
+ * @retval NULL The file couldn't be opened
+ *
+ * The whole of the file is marked as needed soon.  By the time the parser gets
+ * to the file handle, the read will usually have completed in the background.
+ */
+static FILE *maildir_readahead(struct Mailbox *m, struct Maildir *md)
+{
+  char fn[PATH_MAX];
+
+  snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), md->email->path);
+  FILE *fp = fopen(fn, "r");
+#ifdef HAVE_POSIX_FADVISE
+  if (fp)
+    posix_fadvise(fileno(fp), 0, 0, POSIX_FADV_WILLNEED);
+#endif
+  return fp;
+}
+
+#ifdef USE_HCACHE
+/**
+ * struct MaildirHcacheBatch - Messages being looked up in the header cache
+ */
+struct MaildirHcacheBatch
+{
+  struct Mailbox *m;          ///< Mailbox
+  struct Maildir **entries;   ///< Entries whose keys are being looked up
+  struct Progress *progress;  ///< Progress bar
+  int count;                  ///< Number of messages restored
+};
+
+/**
+ * maildir_hcache_key - Get the header cache key of a message
+ * @param[in]  m      Mailbox
+ * @param[in]  e      Email
+ * @param[out] keylen Length of the key
+ * @retval ptr Key, pointing into the Email's path
+ */
+static const char *maildir_hcache_key(struct Mailbox *m, struct Email *e, size_t *keylen)
+{
+  if (m->magic == MUTT_MH)
+  {
+    *keylen = strlen(e->path);
+    return e->path;
+  }
+
+  const char *key = e->path + 3;
+  *keylen = maildir_hcache_keylen(key);
+  return key;
+}
+
+/**
+ * maildir_hcache_restore - Restore a message from the header cache - Implements ::hcache_fetch_t
+ */
+static void maildir_hcache_restore(const void *data, size_t index, void *udata)
+{
+  struct MaildirHcacheBatch *batch = udata;
+  struct Mailbox *m = batch->m;
+  struct Maildir *p = batch->entries[index];
+  char fn[PATH_MAX];
+
+  snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), p->email->path);
+
+  if (C_MaildirHeaderCacheVerify)
+  {
+    struct stat lastchanged = { 0 };
+    const size_t *when = data;
+    if ((stat(fn, &lastchanged) != 0) || (lastchanged.st_mtime > (*when / 1000)))
+      return;
+  }
+
+  struct Email *e = mutt_hcache_restore(data);
+  e->old = p->email->old;
+  e->path = mutt_str_strdup(p->email->path);
+  email_free(&p->email);
+  p->email = e;
+  if (m->magic == MUTT_MAILDIR)
+    maildir_parse_flags(p->email, fn);
+  p->header_parsed = 1;
+
+  batch->count++;
+  if (!m->quiet && batch->progress)
+    mutt_progress_update(batch->progress, batch->count, -1);
+}
+#endif
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
  * @param[in]  m  Mailbox
  * @param[out] md Maildir to parse
  * @param[in]  progress Progress bar
+ *
+ * The work is done in two passes over the (inode-sorted) list:
+ * - First, any messages that are in the header cache are restored
+ * - Then, the remaining messages are parsed from disk
+ *
+ * While parsing, the next #MAILDIR_READAHEAD files are handed to the kernel
+ * for reading, so that the disk is kept busy while we're parsing headers.
+ * The order of the list is never changed by the passes.
  */
 void maildir_delayed_parsing(struct Mailbox *m, struct Maildir **md, struct Progress *progress)
 {
   struct Maildir *p = NULL, *last = NULL;
   char fn[PATH_MAX];
-  int count;
-  bool sort = false;
+  int count = 0;
+
+  for (p = *md; p; p = p->next)
+  {
+    if (p->email && !p->header_parsed)
+      break;
+    last = p;
+  }
+
+  if (!p)
+  {
+    mh_sort_natural(m, md);
+    return;
+  }
+
+  mutt_debug(LL_DEBUG3, "maildir: need to sort %s by inode\n", mailbox_path(m));
+  p = maildir_sort(p, (size_t) -1, md_cmp_inode);
+  if (last)
+    last->next = p;
+  else
+    *md = p;
+  struct Maildir *first = skip_duplicates(p, &last);
 
 #ifdef USE_HCACHE
   header_cache_t *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
-#endif
 
-  for (p = *md, count = 0; p; p = p->next, count++)
+  /* Look up all the unparsed messages in one batch */
+  struct MaildirHcacheBatch batch = { m, NULL, progress, 0 };
+  size_t num = 0;
+  for (p = first; p; p = p->next)
+    if (p->email && !p->header_parsed)
+      num++;
+
+  if (hc && (num > 0))
   {
-    if (!(p && p->email && !p->header_parsed))
+    const char **keys = mutt_mem_calloc(num, sizeof(char *));
+    size_t *keylens = mutt_mem_calloc(num, sizeof(size_t));
+    batch.entries = mutt_mem_calloc(num, sizeof(struct Maildir *));
+
+    size_t i = 0;
+    for (p = first; p; p = p->next)
     {
-      last = p;
-      continue;
+      if (!p->email || p->header_parsed)
+        continue;
+
+      batch.entries[i] = p;
+      keys[i] = maildir_hcache_key(m, p->email, &keylens[i]);
+      i++;
     }
 
-    if (!m->quiet && progress)
-      mutt_progress_update(progress, count, -1);
+    mutt_hcache_fetch_n(hc, keys, keylens, num, maildir_hcache_restore, &batch);
+    count = batch.count;
 
-    if (!sort)
-    {
-      mutt_debug(LL_DEBUG3, "maildir: need to sort %s by inode\n", mailbox_path(m));
-      p = maildir_sort(p, (size_t) -1, md_cmp_inode);
-      if (last)
-        last->next = p;
-      else
-        *md = p;
-      sort = true;
-      p = skip_duplicates(p, &last);
-      snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), p->email->path);
-    }
+    FREE(&keys);
+    FREE(&keylens);
+    FREE(&batch.entries);
+  }
+#endif
 
-    snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), p->email->path);
+  /* Files opened ahead of the parser, in list order */
+  FILE *window[MAILDIR_READAHEAD] = { 0 };
+  struct Maildir *ahead = first;
+  int head = 0;
+  int pending = 0;
 
 #ifdef USE_HCACHE
-    struct stat lastchanged = { 0 };
-    int rc = 0;
-    if (C_MaildirHeaderCacheVerify)
-    {
-      rc = stat(fn, &lastchanged);
-    }
+  /* Write the newly parsed messages to the cache in one batch */
+  mutt_hcache_begin(hc);
+#endif
 
-    const char *key = NULL;
-    size_t keylen = 0;
-    if (m->magic == MUTT_MH)
-    {
-      key = p->email->path;
-      keylen = strlen(key);
-    }
-    else
-    {
-      key = p->email->path + 3;
-      keylen = maildir_hcache_keylen(key);
-    }
-    void *data = mutt_hcache_fetch(hc, key, keylen);
-    size_t *when = data;
+  for (p = first; p; p = p->next)
+  {
+    if (!p->email || p->header_parsed)
+      continue;
 
-    if (data && (rc == 0) && (lastchanged.st_mtime <= (*when / 1000)))
+    /* Keep the kernel a fixed number of files ahead of the parser */
+    for (; ahead && (pending < MAILDIR_READAHEAD); ahead = ahead->next)
     {
-      struct Email *e = mutt_hcache_restore((unsigned char *) data);
-      e->old = p->email->old;
-      e->path = mutt_str_strdup(p->email->path);
-      email_free(&p->email);
-      p->email = e;
-      if (m->magic == MUTT_MAILDIR)
-        maildir_parse_flags(p->email, fn);
+      if (!ahead->email || ahead->header_parsed)
+        continue;
+      window[(head + pending) % MAILDIR_READAHEAD] = maildir_readahead(m, ahead);
+      pending++;
     }
-    else
-    {
-#endif
+    FILE *fp = window[head];
+    window[head] = NULL;
+    head = (head + 1) % MAILDIR_READAHEAD;
+    pending--;
 
-      if (maildir_parse_message(m->magic, fn, p->email->old, p->email))
-      {
-        p->header_parsed = 1;
+    count++;
+    if (!m->quiet && progress)
+      mutt_progress_update(progress, count, -1);
+
+    snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), p->email->path);
+
+    if (fp && maildir_parse_stream(m->magic, fp, fn, p->email->old, p->email))
+    {
+      p->header_parsed = 1;
 #ifdef USE_HCACHE
-        if (m->magic == MUTT_MH)
-        {
-          key = p->email->path;
-          keylen = strlen(key);
-        }
-        else
-        {
-          key = p->email->path + 3;
-          keylen = maildir_hcache_keylen(key);
-        }
-        mutt_hcache_store(hc, key, keylen, p->email, 0);
+      size_t keylen = 0;
+      const char *key = maildir_hcache_key(m, p->email, &keylen);
+      mutt_hcache_store(hc, key, keylen, p->email, 0);
 #endif
-      }
-      else
-        email_free(&p->email);
-#ifdef USE_HCACHE
     }
-    mutt_hcache_free(hc, &data);
-#endif
-    last = p;
+    else
+      email_free(&p->email);
+    mutt_file_fclose(&fp);
   }
 #ifdef USE_HCACHE
+  mutt_hcache_commit(hc);
   mutt_hcache_close(hc);
 #endif
 
@@ -1466,6 +1691,10 @@ bool maildir_update_flags(struct Mailbox *m, struct Email *e_old, struct Email *
   bool header_changed = e_old->changed;
   e_old->changed = false;
 
+  /* The flags changed elsewhere, so the limit has to be applied again */
+  if (header_changed)
+    e_old->limit_checked = false;
+
   /* if the mailbox was not modified before we made these
    * changes, unset the changed flag since nothing needs to
    * be synchronized.  */
@@ -1807,9 +2036,52 @@ int mh_msg_save_hcache(struct Mailbox *m, struct Email *e)
 {
   int rc = 0;
 #ifdef USE_HCACHE
-  header_cache_t *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  header_cache_t *hc = NULL;
+  if (mdata && mdata->hcache)
+    hc = mdata->hcache;
+  else
+    hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
   rc = mutt_hcache_store(hc, e->path, strlen(e->path), e, 0);
-  mutt_hcache_close(hc);
+  if (!mdata || (hc != mdata->hcache))
+    mutt_hcache_close(hc);
+#endif
+  return rc;
+}
+
+/**
+ * mh_hcache_begin - Start a batch of header cache saves - Implements MxOps::hcache_begin()
+ */
+int mh_hcache_begin(struct Mailbox *m)
+{
+#ifdef USE_HCACHE
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  if (!mdata || mdata->hcache)
+    return -1;
+
+  mdata->hcache = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+  if (!mdata->hcache)
+    return -1;
+
+  mutt_hcache_begin(mdata->hcache);
+#endif
+  return 0;
+}
+
+/**
+ * mh_hcache_commit - Finish a batch of header cache saves - Implements MxOps::hcache_commit()
+ */
+int mh_hcache_commit(struct Mailbox *m)
+{
+  int rc = 0;
+#ifdef USE_HCACHE
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  if (!mdata || !mdata->hcache)
+    return -1;
+
+  rc = mutt_hcache_commit(mdata->hcache);
+  mutt_hcache_close(mdata->hcache);
+  mdata->hcache = NULL;
 #endif
   return rc;
 }
@@ -70,6 +70,7 @@
 #include "mx.h"
 #include "myvar.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 #include "send.h"
 #include "sendlib.h"
@@ -752,6 +753,7 @@ int main(int argc, char *argv[], char *envp[])
   notify_observer_add(NeoMutt->notify, mutt_log_observer, NULL);
   notify_observer_add(NeoMutt->notify, mutt_menu_config_observer, NULL);
   notify_observer_add(NeoMutt->notify, mutt_reply_observer, NULL);
+  notify_observer_add(NeoMutt->notify, mutt_pattern_memo_observer, NULL);
   notify_observer_add(NeoMutt->notify, mutt_abort_key_config_observer, NULL);
   if (Colors)
     notify_observer_add(Colors->notify, mutt_menu_color_observer, NULL);
@@ -1215,6 +1217,7 @@ main_exit:
   mutt_browser_cleanup();
   mutt_opts_free();
   mutt_keys_free();
+  mutt_expando_cleanup();
   myvarlist_free(&MyVars);
   neomutt_free(&NeoMutt);
   cs_free(&cs);
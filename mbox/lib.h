@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <time.h>
 #include "core/lib.h"
+#include "hcache/lib.h"
 #include "mx.h"
 
 struct stat;
@@ -50,10 +51,19 @@ struct MboxAccountData
   FILE *fp;              ///< Mailbox file
   struct timespec atime; ///< File's last-access time
 
-  bool locked : 1; ///< is the mailbox locked?
-  bool append : 1; ///< mailbox is opened in append mode
+  bool locked : 1;     ///< is the mailbox locked?
+  bool append : 1;     ///< mailbox is opened in append mode
+  bool tail_valid : 1; ///< tail_checksum has been set
+
+  LOFF_T tail_size;            ///< Size of the file when tail_checksum was taken
+  unsigned char tail_checksum[16]; ///< Checksum of the end of the file, see mbox_tail_checksum()
+
+  header_cache_t *hcache; ///< Header cache held open by mbox_hcache_begin()
 };
 
+/* These Config Variables are only used in mbox/mbox.c */
+extern bool C_MboxHeaderCache;
+
 extern struct MxOps MxMboxOps;
 extern struct MxOps MxMmdfOps;
 
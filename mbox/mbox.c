@@ -37,6 +37,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -56,6 +59,31 @@
 #include "progress.h"
 #include "protos.h"
 #include "sort.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
+
+/* These Config Variables are only used in mbox/mbox.c */
+bool C_MboxHeaderCache; ///< Config: (hcache) Cache the headers of mbox folders
+
+#define MBOX_TAIL_CHECKSUM 4096 ///< Number of bytes covered by mbox_tail_checksum()
+
+#ifdef USE_HCACHE
+/**
+ * struct MboxHcacheIndex - Summary of an mbox mailbox stored in the header cache
+ *
+ * The emails themselves are stored under the keys "/0", "/1", etc.
+ */
+struct MboxHcacheIndex
+{
+  unsigned int crc;          ///< Header cache version, see mutt_hcache_open()
+  LOFF_T size;               ///< Size of the mailbox file
+  struct timespec mtime;     ///< Modification time of the mailbox file
+  int msg_count;             ///< Number of emails stored
+  unsigned char checksum[16]; ///< MD5 of the last #MBOX_TAIL_CHECKSUM bytes of the file
+  unsigned char head[16];    ///< MD5 of the first "From " line of the file
+};
+#endif
 
 /**
  * struct MUpdate - Store of new offsets, used by mutt_sync_mailbox()
@@ -172,6 +200,45 @@ static void mbox_unlock_mailbox(struct Mailbox *m)
   }
 }
 
+/**
+ * mbox_tail_checksum - Checksum the end of a section of the mailbox
+ * @param[in]  fp       Mailbox file
+ * @param[in]  size     Length of the section, from the start of the file
+ * @param[out] checksum Buffer for the MD5 checksum (16 bytes)
+ * @retval true Success
+ *
+ * Only the last #MBOX_TAIL_CHECKSUM bytes of the section are checksummed.
+ */
+static bool mbox_tail_checksum(FILE *fp, LOFF_T size, unsigned char *checksum)
+{
+  char buf[MBOX_TAIL_CHECKSUM];
+  size_t len = MIN(size, (LOFF_T) sizeof(buf));
+
+  if ((fseeko(fp, size - len, SEEK_SET) != 0) || (fread(buf, 1, len, fp) != len))
+    return false;
+
+  mutt_md5_bytes(buf, len, checksum);
+  return true;
+}
+
+/**
+ * mbox_remember_tail - Take a checksum of the end of the mailbox
+ * @param m Mailbox
+ *
+ * This allows mbox_mbox_check() to tell if the mail that has been read is
+ * still intact.
+ */
+static void mbox_remember_tail(struct Mailbox *m)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+
+  adata->tail_size = m->size;
+  adata->tail_valid = mbox_tail_checksum(adata->fp, m->size, adata->tail_checksum);
+
+  if (fseeko(adata->fp, m->size, SEEK_SET) != 0)
+    mutt_debug(LL_DEBUG1, "fseek() failed\n");
+}
+
 /**
  * mmdf_parse_mailbox - Read a mailbox in MMDF format
  * @param m Mailbox
@@ -316,20 +383,588 @@ static int mmdf_parse_mailbox(struct Mailbox *m)
     }
     else
     {
-      mutt_debug(LL_DEBUG1, "corrupt mailbox\n");
-      mutt_error(_("Mailbox is corrupt"));
-      return -1;
+      mutt_debug(LL_DEBUG1, "corrupt mailbox\n");
+      mutt_error(_("Mailbox is corrupt"));
+      return -1;
+    }
+  }
+
+  if (SigInt == 1)
+  {
+    SigInt = 0;
+    return -2; /* action aborted */
+  }
+
+  mbox_remember_tail(m);
+  return 0;
+}
+
+#ifdef USE_HCACHE
+/**
+ * mbox_hcache_open - Open the header cache for an mbox mailbox
+ * @param m Mailbox
+ * @retval ptr  Header cache
+ * @retval NULL Caching is disabled, or failed
+ */
+static header_cache_t *mbox_hcache_open(struct Mailbox *m)
+{
+  if (!C_MboxHeaderCache || (m->magic != MUTT_MBOX))
+    return NULL;
+
+  return mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+}
+
+/**
+ * mbox_hcache_is_from - Is there a "From " line at an offset in the mailbox?
+ * @param fp  Mailbox file
+ * @param loc Offset in the file
+ * @retval true There's a message separator at the offset
+ */
+static bool mbox_hcache_is_from(FILE *fp, LOFF_T loc)
+{
+  char buf[8];
+
+  return (fseeko(fp, loc, SEEK_SET) == 0) && fgets(buf, sizeof(buf), fp) &&
+         mutt_str_startswith(buf, "From ", CASE_MATCH);
+}
+
+/**
+ * mbox_hcache_head_checksum - Checksum the first line of the mailbox
+ * @param[in]  fp       Mailbox file
+ * @param[out] checksum Buffer for the MD5 checksum (16 bytes)
+ * @retval true Success
+ *
+ * The first "From " line holds the sender and date of the first message.
+ */
+static bool mbox_hcache_head_checksum(FILE *fp, unsigned char *checksum)
+{
+  char buf[1024];
+
+  if ((fseeko(fp, 0, SEEK_SET) != 0) || !fgets(buf, sizeof(buf), fp) ||
+      !mutt_str_startswith(buf, "From ", CASE_MATCH))
+  {
+    return false;
+  }
+
+  mutt_md5_bytes(buf, strlen(buf), checksum);
+  return true;
+}
+
+/**
+ * mbox_hcache_check_offsets - Do the cached emails match the mailbox?
+ * @param m    Mailbox
+ * @param size Size of the part of the file described by the cache
+ * @retval true Every email starts with a "From " line, in file order
+ */
+static bool mbox_hcache_check_offsets(struct Mailbox *m, LOFF_T size)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  LOFF_T prev = -1;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    const LOFF_T offset = m->emails[i]->offset;
+    if ((offset <= prev) || (offset >= size) ||
+        !mbox_hcache_is_from(adata->fp, offset))
+    {
+      return false;
+    }
+    prev = offset;
+  }
+
+  return true;
+}
+
+/**
+ * mbox_hcache_load - Restore the emails of an mbox mailbox from the header cache
+ * @param m Mailbox
+ * @retval num Offset in the file from which to carry on parsing
+ *
+ * The cache is used if the part of the mailbox it describes is unchanged,
+ * judged by its size, modification time, checksums of its first line and its
+ * end, and a "From " line at the offset of every cached email.  If new messages
+ * have been appended since, the caller only needs to parse those.
+ */
+static LOFF_T mbox_hcache_load(struct Mailbox *m)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  header_cache_t *hc = mbox_hcache_open(m);
+  if (!hc)
+    return 0;
+
+  LOFF_T loc = 0;
+  unsigned char checksum[16];
+  char key[32];
+
+  /* Take a copy: fetching the emails may reuse the memory of the index */
+  struct MboxHcacheIndex idx;
+  size_t dlen = 0;
+  void *data = mutt_hcache_fetch_raw(hc, "/index", 6, &dlen);
+  if (!data)
+    goto done;
+  if (dlen < sizeof(idx))
+  {
+    mutt_hcache_free(hc, &data);
+    goto done;
+  }
+  memcpy(&idx, data, sizeof(idx));
+  mutt_hcache_free(hc, &data);
+
+  if ((idx.crc != hc->crc) || (idx.msg_count <= 0) || (idx.size > m->size))
+    goto done;
+
+  /* Same size, but touched: the messages may have been rewritten in place */
+  if ((idx.size == m->size) && (mutt_file_timespec_compare(&idx.mtime, &m->mtime) != 0))
+    goto done;
+
+  if (!mbox_tail_checksum(adata->fp, idx.size, checksum) ||
+      (memcmp(checksum, idx.checksum, sizeof(checksum)) != 0))
+  {
+    goto done;
+  }
+
+  if (!mbox_hcache_head_checksum(adata->fp, checksum) ||
+      (memcmp(checksum, idx.head, sizeof(checksum)) != 0))
+  {
+    goto done;
+  }
+
+  /* Anything new must have been appended as whole messages */
+  if ((idx.size < m->size) && !mbox_hcache_is_from(adata->fp, idx.size))
+    goto done;
+
+  mx_alloc_memory_n(m, idx.msg_count);
+  for (int i = 0; i < idx.msg_count; i++)
+  {
+    int keylen = snprintf(key, sizeof(key), "/%d", i);
+    struct Email *e = mutt_hcache_fetch_email(hc, key, keylen, NULL);
+    if (!e)
+      break;
+
+    e->index = m->msg_count;
+    m->emails[m->msg_count++] = e;
+  }
+
+  if ((m->msg_count != idx.msg_count) ||
+      !mbox_hcache_check_offsets(m, idx.size))
+  {
+    mutt_debug(LL_DEBUG1, "header cache for %s is incomplete\n", mailbox_path(m));
+    for (int i = 0; i < m->msg_count; i++)
+      email_free(&m->emails[i]);
+    m->msg_count = 0;
+    goto done;
+  }
+
+  mutt_debug(LL_DEBUG2, "restored %d emails of %s from the header cache\n",
+             m->msg_count, mailbox_path(m));
+  loc = idx.size;
+
+done:
+  mutt_hcache_close(hc);
+
+  if (fseeko(adata->fp, loc, SEEK_SET) != 0)
+    mutt_debug(LL_DEBUG1, "fseek() failed\n");
+
+  return loc;
+}
+
+/**
+ * mbox_hcache_save - Save the emails of an mbox mailbox to the header cache
+ * @param m     Mailbox
+ * @param first Index of the first email that isn't cached yet
+ *
+ * This must be called immediately after parsing, while the emails still match
+ * the file.  If the cache doesn't already hold exactly the emails before
+ * @a first, e.g. after a sync, all of them are saved.  Nothing is saved if an
+ * email has been changed, or the emails are no longer in file order.
+ */
+static void mbox_hcache_save(struct Mailbox *m, int first)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  struct MboxHcacheIndex idx = { 0 };
+  char key[32];
+
+  header_cache_t *hc = mbox_hcache_open(m);
+  if (!hc)
+    return;
+
+  if (!adata->tail_valid || (adata->tail_size != m->size))
+    goto done;
+
+  if (first > 0)
+  {
+    size_t dlen = 0;
+    void *data = mutt_hcache_fetch_raw(hc, "/index", 6, &dlen);
+    if (data)
+    {
+      if (dlen >= sizeof(idx))
+        memcpy(&idx, data, sizeof(idx));
+      mutt_hcache_free(hc, &data);
+    }
+
+    if ((idx.crc != hc->crc) || (idx.msg_count != first))
+      first = 0;
+    memset(&idx, 0, sizeof(idx));
+  }
+
+  /* The cache must describe the file, not the emails in memory */
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (((i >= first) && e->changed) ||
+        ((i > 0) && (e->offset <= m->emails[i - 1]->offset)))
+    {
+      goto done;
+    }
+  }
+
+  memcpy(idx.checksum, adata->tail_checksum, sizeof(idx.checksum));
+  if (!mbox_hcache_head_checksum(adata->fp, idx.head))
+    goto done;
+
+  /* Don't leave an index pointing at emails that are being replaced */
+  if (first == 0)
+    mutt_hcache_delete_header(hc, "/index", 6);
+
+  for (int i = first; i < m->msg_count; i++)
+  {
+    int keylen = snprintf(key, sizeof(key), "/%d", i);
+    if (mutt_hcache_store(hc, key, keylen, m->emails[i], 0) != 0)
+      goto done;
+  }
+
+  idx.crc = hc->crc;
+  idx.size = m->size;
+  idx.mtime = m->mtime;
+  idx.msg_count = m->msg_count;
+  mutt_hcache_store_raw(hc, "/index", 6, &idx, sizeof(idx));
+
+done:
+  mutt_hcache_close(hc);
+
+  /* leave the FILE where the parser did */
+  if (fseeko(adata->fp, m->size, SEEK_SET) != 0)
+    mutt_debug(LL_DEBUG1, "fseek() failed\n");
+}
+
+/**
+ * mbox_hcache_update - Update the cached copy of an email
+ * @param m     Mailbox
+ * @param e     Email
+ * @param msgno Position of the email in the file
+ *
+ * If the email has unsaved changes, or can't be stored, the cached copy would
+ * no longer match the file, so the rest of the cache is forgotten.
+ */
+static void mbox_hcache_update(struct Mailbox *m, struct Email *e, int msgno)
+{
+  header_cache_t *hc = mbox_hcache_open(m);
+  if (!hc)
+    return;
+
+  char key[32];
+  int keylen = snprintf(key, sizeof(key), "/%d", msgno);
+  if (e->changed || (mutt_hcache_store(hc, key, keylen, e, 0) != 0))
+    mutt_hcache_delete_header(hc, "/index", 6);
+  mutt_hcache_close(hc);
+}
+
+/**
+ * mbox_hcache_invalidate - Forget the cached emails of an mbox mailbox
+ * @param m Mailbox
+ *
+ * After a sync, the cached emails no longer match the file.
+ */
+static void mbox_hcache_invalidate(struct Mailbox *m)
+{
+  header_cache_t *hc = mbox_hcache_open(m);
+  if (!hc)
+    return;
+
+  mutt_hcache_delete_header(hc, "/index", 6);
+  mutt_hcache_close(hc);
+}
+#endif
+
+#ifdef HAVE_MMAP
+/**
+ * mbox_count_lines - Count the lines in a block of memory
+ * @param buf Start of the block
+ * @param len Length of the block
+ * @retval num Number of newline characters
+ */
+static long mbox_count_lines(const char *buf, size_t len)
+{
+  const char *end = buf + len;
+  long lines = 0;
+
+  while ((buf < end) && (buf = memchr(buf, '\n', end - buf)))
+  {
+    lines++;
+    buf++;
+  }
+
+  return lines;
+}
+
+/**
+ * mbox_read_from_line - Copy and check a "From " line from a mapped mailbox
+ * @param[in]  map         Mapping of the mailbox file
+ * @param[in]  size        Size of the mapping
+ * @param[in]  loc         Offset of the start of the line
+ * @param[out] next        Offset of the following line
+ * @param[out] return_path Buffer for the Return-Path (OPTIONAL)
+ * @param[in]  rplen       Length of the Return-Path buffer
+ * @param[out] t           Time from the line (OPTIONAL)
+ * @retval true The line is a valid message separator
+ *
+ * is_from() needs a string, so the line is copied, as fgets() would.
+ */
+static bool mbox_read_from_line(const char *map, LOFF_T size, LOFF_T loc, LOFF_T *next,
+                                char *return_path, size_t rplen, time_t *t)
+{
+  char buf[8192];
+  const char *line = map + loc;
+  const char *eol = memchr(line, '\n', size - loc);
+
+  *next = eol ? (eol - map + 1) : size;
+
+  if (((size - loc) < 5) || (memcmp(line, "From ", 5) != 0))
+    return false;
+
+  size_t len = MIN((size_t)(*next - loc), sizeof(buf) - 1);
+  memcpy(buf, line, len);
+  buf[len] = '\0';
+
+  return is_from(buf, return_path, rplen, t);
+}
+
+/**
+ * mbox_index_mapped - Find all the message separators in a mapped mailbox
+ * @param[in]  map     Mapping of the mailbox file
+ * @param[in]  size    Size of the mapping
+ * @param[in]  loc     Offset to start searching from
+ * @param[out] offsets Array of offsets of the separators
+ * @retval num Number of separators found
+ *
+ * The array is allocated and must be freed by the caller.
+ *
+ * @note Some of these may turn out to be inside a message whose
+ *       Content-Length header says to skip over them.
+ */
+static int mbox_index_mapped(const char *map, LOFF_T size, LOFF_T loc, LOFF_T **offsets)
+{
+  int count = 0;
+  int max = 0;
+  LOFF_T next;
+
+  *offsets = NULL;
+
+  while (loc < size)
+  {
+    if (mbox_read_from_line(map, size, loc, &next, NULL, 0, NULL))
+    {
+      if (count == max)
+      {
+        max = max ? (max * 2) : 256;
+        mutt_mem_realloc(offsets, max * sizeof(LOFF_T));
+      }
+      (*offsets)[count++] = loc;
+    }
+
+    const char *from = memmem(map + loc, size - loc, "\nFrom ", 6);
+    loc = from ? (from - map + 1) : size;
+  }
+
+  return count;
+}
+
+/**
+ * mbox_parse_mapped - Read a memory-mapped mailbox
+ * @param m        Mailbox
+ * @param map      Mapping of the whole mailbox file
+ * @param progress Progress bar (only valid if the Mailbox isn't quiet)
+ * @retval  0 Success
+ * @retval -1 Error
+ * @retval -2 Aborted
+ *
+ * This behaves exactly like the stdio loop in mbox_parse_mailbox(), but the
+ * message bodies are never read line by line.
+ *
+ * First, the mailbox is split into messages by searching for "From " lines
+ * with memmem().  Knowing how many messages to expect, the Mailbox's storage
+ * can be allocated in one go.  Then the headers of each message are read
+ * through the FILE, and memchr() is used to count the lines of the bodies.
+ */
+static int mbox_parse_mapped(struct Mailbox *m, const char *map, struct Progress *progress)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  char return_path[256];
+  struct Email *e_cur = NULL;
+  LOFF_T *offsets = NULL;
+  time_t t;
+  int count = 0;
+  long lines = 0;
+  LOFF_T next;
+  const LOFF_T size = m->size;
+  int rc = 0;
+
+  LOFF_T loc = ftello(adata->fp);
+  if (loc < 0)
+    return -1;
+
+  const int num_from = mbox_index_mapped(map, size, loc, &offsets);
+  mx_alloc_memory_n(m, num_from);
+
+  if (!m->quiet)
+  {
+    char msg[PATH_MAX];
+    snprintf(msg, sizeof(msg), _("Reading %s..."), mailbox_path(m));
+    mutt_progress_init(progress, msg, MUTT_PROGRESS_READ, num_from);
+  }
+
+  for (int i = 0; (i < num_from) && (SigInt != 1); i++)
+  {
+    /* Skip the separators inside a message with a valid Content-Length */
+    if (offsets[i] < loc)
+      continue;
+
+    lines += mbox_count_lines(map + loc, offsets[i] - loc);
+    loc = offsets[i];
+
+    mbox_read_from_line(map, size, loc, &next, return_path, sizeof(return_path), &t);
+
+    /* Save the Content-Length of the previous message */
+    if (count > 0)
+    {
+      struct Email *e = m->emails[m->msg_count - 1];
+      if (e->content->length < 0)
+      {
+        e->content->length = loc - e->content->offset - 1;
+        if (e->content->length < 0)
+          e->content->length = 0;
+      }
+      if (!e->lines)
+        e->lines = lines ? lines - 1 : 0;
+    }
+
+    count++;
+
+    if (!m->quiet)
+      mutt_progress_update(progress, i + 1, -1);
+
+    if (m->msg_count == m->email_max)
+      mx_alloc_memory(m);
+
+    m->emails[m->msg_count] = email_new();
+    e_cur = m->emails[m->msg_count];
+    e_cur->received = t - mutt_date_local_tz(t);
+    e_cur->offset = loc;
+    e_cur->index = m->msg_count;
+
+    if (fseeko(adata->fp, next, SEEK_SET) != 0)
+    {
+      rc = -1;
+      goto done;
+    }
+    e_cur->env = mutt_rfc822_read_header(adata->fp, e_cur, false, false);
+
+    loc = ftello(adata->fp);
+    if (loc < 0)
+    {
+      rc = -1;
+      goto done;
+    }
+
+    /* if we know how long this message is, skip over the body */
+    if (e_cur->content->length > 0)
+    {
+      /* The test below avoids a potential integer overflow if the
+       * content-length is huge (thus necessarily invalid).  */
+      LOFF_T tmploc = (e_cur->content->length < size) ?
+                          (loc + e_cur->content->length + 1) :
+                          -1;
+
+      if ((tmploc > 0) && (tmploc < size))
+      {
+        /* check to see if the content-length looks valid.  we expect to
+         * to see a valid message separator at this point in the file */
+        if (((size - tmploc) < 5) || (memcmp(map + tmploc, "From ", 5) != 0))
+        {
+          mutt_debug(LL_DEBUG1, "bad content-length in message %d (cl=" OFF_T_FMT ")\n",
+                     e_cur->index, e_cur->content->length);
+          e_cur->content->length = -1;
+        }
+      }
+      else if (tmploc != size)
+      {
+        /* content-length would put us past the end of the file, so it
+         * must be wrong */
+        e_cur->content->length = -1;
+      }
+
+      if (e_cur->content->length != -1)
+      {
+        /* good content-length.  check to see if we know how many lines
+         * are in this message.  */
+        if (e_cur->lines == 0)
+          e_cur->lines = mbox_count_lines(map + loc, e_cur->content->length);
+
+        loc = tmploc;
+      }
+    }
+
+    m->msg_count++;
+
+    if (TAILQ_EMPTY(&e_cur->env->return_path) && return_path[0])
+    {
+      mutt_addrlist_parse(&e_cur->env->return_path, return_path);
+    }
+
+    if (TAILQ_EMPTY(&e_cur->env->from))
+      mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
+
+    lines = 0;
+  }
+
+  if (loc < size)
+  {
+    lines += mbox_count_lines(map + loc, size - loc);
+    if (map[size - 1] != '\n')
+      lines++; /* fgets() would have counted the final, partial line */
+  }
+
+  /* Only set the content-length of the previous message if we have read more
+   * than one message during _this_ invocation.  See mbox_parse_mailbox() */
+  if (count > 0)
+  {
+    struct Email *e = m->emails[m->msg_count - 1];
+    if (e->content->length < 0)
+    {
+      e->content->length = size - e->content->offset - 1;
+      if (e->content->length < 0)
+        e->content->length = 0;
     }
+
+    if (!e->lines)
+      e->lines = lines ? lines - 1 : 0;
   }
 
+  /* leave the FILE where the stdio parser would have */
+  if (fseeko(adata->fp, size, SEEK_SET) != 0)
+    mutt_debug(LL_DEBUG1, "fseek() failed\n");
+
   if (SigInt == 1)
   {
     SigInt = 0;
-    return -2; /* action aborted */
+    rc = -2; /* action aborted */
   }
 
-  return 0;
+done:
+  FREE(&offsets);
+  return rc;
 }
+#endif
 
 /**
  * mbox_parse_mailbox - Read a mailbox from disk
@@ -360,6 +995,7 @@ static int mbox_parse_mailbox(struct Mailbox *m)
   int count = 0, lines = 0;
   LOFF_T loc;
   struct Progress progress;
+  int rc = 0;
 
   /* Save information about the folder at the time we opened it. */
   if (stat(mailbox_path(m), &sb) == -1)
@@ -383,9 +1019,37 @@ static int mbox_parse_mailbox(struct Mailbox *m)
   }
 
   loc = ftello(adata->fp);
+#ifdef USE_HCACHE
+  /* Only the appended messages need parsing, if the cache is up to date */
+  if ((m->msg_count == 0) && (loc == 0))
+    loc = mbox_hcache_load(m);
+  const int first = m->msg_count;
+#endif
+
+#ifdef HAVE_MMAP
+  /* If the file can be mapped, avoid reading every line of every message */
+  if (m->size > 0)
+  {
+    void *map = mmap(NULL, m->size, PROT_READ, MAP_SHARED, fileno(adata->fp), 0);
+    if (map != MAP_FAILED)
+    {
+      posix_madvise(map, m->size, POSIX_MADV_SEQUENTIAL);
+      rc = mbox_parse_mapped(m, map, &progress);
+      munmap(map, m->size);
+      goto done;
+    }
+    mutt_debug(LL_DEBUG1, "mmap() failed, reading %s line by line\n", mailbox_path(m));
+  }
+#endif
+
+  bool bol = true; /* buf is at the beginning of a line */
   while ((fgets(buf, sizeof(buf), adata->fp)) && (SigInt != 1))
   {
-    if (is_from(buf, return_path, sizeof(return_path), &t))
+    /* A line longer than buf is read in pieces.  Only count it once, like
+     * mbox_parse_mapped() does. */
+    bool eol = strchr(buf, '\n') || feof(adata->fp);
+
+    if (bol && is_from(buf, return_path, sizeof(return_path), &t))
     {
       /* Save the Content-Length of the previous message */
       if (count > 0)
@@ -496,10 +1160,12 @@ static int mbox_parse_mailbox(struct Mailbox *m)
         mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
 
       lines = 0;
+      eol = true;
     }
-    else
+    else if (eol)
       lines++;
 
+    bol = eol;
     loc = ftello(adata->fp);
   }
 
@@ -524,10 +1190,19 @@ static int mbox_parse_mailbox(struct Mailbox *m)
   if (SigInt == 1)
   {
     SigInt = 0;
-    return -2; /* action aborted */
+    rc = -2; /* action aborted */
   }
 
-  return 0;
+#ifdef HAVE_MMAP
+done:
+#endif
+  if (rc == 0)
+    mbox_remember_tail(m);
+#ifdef USE_HCACHE
+  if ((rc == 0) && (m->msg_count > first))
+    mbox_hcache_save(m, first);
+#endif
+  return rc;
 }
 
 /**
@@ -1020,6 +1695,112 @@ static int mbox_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
   return 0;
 }
 
+/**
+ * mbox_find_appended - Check that mail has only been appended to a mailbox
+ * @param[in]  m      Mailbox
+ * @param[out] loc    Offset of the first new message
+ * @param[out] blanks Number of blank lines before the first new message
+ * @retval true Only new messages have been appended
+ *
+ * The end of the mail we've already read must be unchanged, and must be
+ * followed by a message separator.  Some MDAs write a blank line before the
+ * separator if the mbox didn't end with one; these are skipped.
+ */
+static bool mbox_find_appended(struct Mailbox *m, LOFF_T *loc, int *blanks)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  unsigned char checksum[16];
+  char buf[1024];
+
+  if (adata->tail_valid && (adata->tail_size == m->size))
+  {
+    if (!mbox_tail_checksum(adata->fp, m->size, checksum) ||
+        (memcmp(checksum, adata->tail_checksum, sizeof(checksum)) != 0))
+    {
+      mutt_debug(LL_DEBUG1, "the end of the mailbox has changed\n");
+      return false;
+    }
+  }
+
+  if (fseeko(adata->fp, m->size, SEEK_SET) != 0)
+  {
+    mutt_debug(LL_DEBUG1, "#1 fseek() failed\n");
+    return false;
+  }
+
+  *blanks = 0;
+  while (true)
+  {
+    *loc = ftello(adata->fp);
+    if ((*loc < 0) || !fgets(buf, sizeof(buf), adata->fp))
+    {
+      mutt_debug(LL_DEBUG1, "fgets returned NULL\n");
+      return false;
+    }
+
+    if ((m->magic == MUTT_MBOX) && (buf[0] == '\n') && (m->msg_count > 0))
+      (*blanks)++;
+    else
+      break;
+  }
+
+  return ((m->magic == MUTT_MBOX) && mutt_str_startswith(buf, "From ", CASE_MATCH)) ||
+         ((m->magic == MUTT_MMDF) && (mutt_str_strcmp(buf, MMDF_SEP) == 0));
+}
+
+/**
+ * mbox_extend_last - Add blank lines to the end of the last message
+ * @param m      Mailbox
+ * @param loc    Offset of the first new message
+ * @param blanks Number of blank lines before the new message
+ *
+ * This leaves the message as a full reparse of the mailbox would.
+ */
+static void mbox_extend_last(struct Mailbox *m, LOFF_T loc, int blanks)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  struct Email *e_last = NULL;
+  char buf[8192];
+
+  /* The Mailbox may be sorted, so find the message nearest the end of the file */
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e_last || (e->offset > e_last->offset))
+      e_last = e;
+  }
+
+  if (!e_last)
+    return;
+
+  /* The Content-Length can't be right any more */
+  e_last->content->length += blanks;
+
+  /* Unless there's a Lines header, the body's lines have to be counted again */
+  struct Email *e_tmp = email_new();
+  if ((fseeko(adata->fp, e_last->offset, SEEK_SET) == 0) && fgets(buf, sizeof(buf), adata->fp))
+  {
+    e_tmp->env = mutt_rfc822_read_header(adata->fp, e_tmp, false, false);
+    if (e_tmp->lines == 0)
+    {
+      int lines = 0;
+      while ((ftello(adata->fp) < loc) && fgets(buf, sizeof(buf), adata->fp))
+      {
+        /* Count a line longer than buf once, as the parsers do */
+        if (strchr(buf, '\n'))
+          lines++;
+      }
+      e_last->lines = lines ? lines - 1 : 0;
+    }
+  }
+  email_free(&e_tmp);
+
+#ifdef USE_HCACHE
+  /* The last message in the file is the last one in the cache */
+  mbox_hcache_update(m, e_last, m->msg_count - 1);
+#endif
+}
+
 /**
  * mbox_mbox_check - Check for new mail - Implements MxOps::mbox_check()
  * @param[in]  m          Mailbox
@@ -1083,48 +1864,42 @@ static int mbox_mbox_check(struct Mailbox *m, int *index_hint)
       }
 
       /* Check to make sure that the only change to the mailbox is that
-       * message(s) were appended to this file.  My heuristic is that we should
-       * see the message separator at *exactly* what used to be the end of the
-       * folder.  */
-      char buf[1024];
-      if (fseeko(adata->fp, m->size, SEEK_SET) != 0)
-        mutt_debug(LL_DEBUG1, "#1 fseek() failed\n");
-      if (fgets(buf, sizeof(buf), adata->fp))
+       * message(s) were appended to this file.  The mail we've read must be
+       * unchanged and we should see the message separator at what used to be
+       * the end of the folder.  */
+      LOFF_T loc = 0;
+      int blanks = 0;
+      if (mbox_find_appended(m, &loc, &blanks))
       {
-        if (((m->magic == MUTT_MBOX) && mutt_str_startswith(buf, "From ", CASE_MATCH)) ||
-            ((m->magic == MUTT_MMDF) && (mutt_str_strcmp(buf, MMDF_SEP) == 0)))
-        {
-          if (fseeko(adata->fp, m->size, SEEK_SET) != 0)
-            mutt_debug(LL_DEBUG1, "#2 fseek() failed\n");
-
-          int old_msg_count = m->msg_count;
-          if (m->magic == MUTT_MBOX)
-            mbox_parse_mailbox(m);
-          else
-            mmdf_parse_mailbox(m);
-
-          if (m->msg_count > old_msg_count)
-            mailbox_changed(m, NT_MAILBOX_INVALID);
-
-          /* Only unlock the folder if it was locked inside of this routine.
-           * It may have been locked elsewhere, like in
-           * mutt_checkpoint_mailbox().  */
-          if (unlock)
-          {
-            mbox_unlock_mailbox(m);
-            mutt_sig_unblock();
-          }
+        /* The blank lines belong to the body of the last message */
+        if (blanks > 0)
+          mbox_extend_last(m, loc, blanks);
 
-          return MUTT_NEW_MAIL; /* signal that new mail arrived */
-        }
+        if (fseeko(adata->fp, loc, SEEK_SET) != 0)
+          mutt_debug(LL_DEBUG1, "#2 fseek() failed\n");
+
+        int old_msg_count = m->msg_count;
+        if (m->magic == MUTT_MBOX)
+          mbox_parse_mailbox(m);
         else
-          modified = true;
+          mmdf_parse_mailbox(m);
+
+        if (m->msg_count > old_msg_count)
+          mailbox_changed(m, NT_MAILBOX_INVALID);
+
+        /* Only unlock the folder if it was locked inside of this routine.
+         * It may have been locked elsewhere, like in
+         * mutt_checkpoint_mailbox().  */
+        if (unlock)
+        {
+          mbox_unlock_mailbox(m);
+          mutt_sig_unblock();
+        }
+
+        return MUTT_NEW_MAIL; /* signal that new mail arrived */
       }
       else
-      {
-        mutt_debug(LL_DEBUG1, "fgets returned NULL\n");
         modified = true;
-      }
     }
     else
       modified = true;
@@ -1153,6 +1928,220 @@ static int mbox_mbox_check(struct Mailbox *m, int *index_hint)
   return -1;
 }
 
+/**
+ * struct MboxStatusField - Location of a status field of an Email in the mailbox
+ */
+struct MboxStatusField
+{
+  LOFF_T offset; ///< Offset of the field's value, after the colon
+  int len;       ///< Length of the field's value, or -1 if it's missing
+};
+
+/**
+ * mbox_find_status - Find the status fields in the header of an Email
+ * @param[in]  fp      Mailbox file
+ * @param[in]  e       Email
+ * @param[out] status  Location of the "Status:" field
+ * @param[out] xstatus Location of the "X-Status:" field
+ * @retval true The header is understood
+ */
+static bool mbox_find_status(FILE *fp, struct Email *e, struct MboxStatusField *status,
+                             struct MboxStatusField *xstatus)
+{
+  char buf[1024];
+  bool bol = true;
+
+  status->len = -1;
+  xstatus->len = -1;
+
+  if (fseeko(fp, e->offset, SEEK_SET) != 0)
+    return false;
+
+  LOFF_T loc = e->offset;
+  while ((loc < e->content->offset) && fgets(buf, sizeof(buf), fp))
+  {
+    size_t len = mutt_str_strlen(buf);
+    bool eol = (len > 0) && (buf[len - 1] == '\n');
+
+    struct MboxStatusField *field = NULL;
+    size_t name_len = 0;
+    if (bol && eol && mutt_str_startswith(buf, "Status:", CASE_IGNORE))
+    {
+      field = status;
+      name_len = 7;
+    }
+    else if (bol && eol && mutt_str_startswith(buf, "X-Status:", CASE_IGNORE))
+    {
+      field = xstatus;
+      name_len = 9;
+    }
+
+    if (field)
+    {
+      /* Duplicates would need to be cleared, too */
+      if (field->len >= 0)
+        return false;
+      field->offset = loc + name_len;
+      field->len = len - name_len - 1;
+    }
+
+    loc += len;
+    bol = eol;
+  }
+
+  return true;
+}
+
+/**
+ * mbox_write_status - Overwrite the value of a status field
+ * @param fp    Mailbox file
+ * @param field Location of the field
+ * @param value New value, e.g. "RO"
+ * @retval  0 Success
+ * @retval -1 Error
+ *
+ * The value is padded with spaces to fill the space of the old value.
+ * Emptying a field is left to a rewrite of the mailbox, which removes it.
+ */
+static int mbox_write_status(FILE *fp, const struct MboxStatusField *field, const char *value)
+{
+  char buf[1024];
+
+  if (!*value)
+    return 0;
+
+  snprintf(buf, sizeof(buf), " %s%-*s", value, field->len, "");
+  if ((fseeko(fp, field->offset, SEEK_SET) != 0) || (fwrite(buf, 1, field->len, fp) != field->len))
+    return -1;
+
+  return 0;
+}
+
+/**
+ * mbox_sync_in_place - Save the changed flags of the emails without moving any data
+ * @param m Mailbox
+ * @retval  0 Success
+ * @retval  1 The mailbox needs to be rewritten
+ * @retval -1 Error
+ *
+ * If the only changes are to the emails' flags and the existing "Status:" and
+ * "X-Status:" fields have room for the new values, they are overwritten.  When
+ * the mailbox is rewritten, these fields are padded for this in the emails
+ * whose flags have changed.  A field that would become empty is left to the
+ * rewrite, which drops it.
+ */
+static int mbox_sync_in_place(struct Mailbox *m)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  struct MboxStatusField *fields = NULL;
+  char status[4], xstatus[4];
+  int num_changed = 0;
+  int rc = 1;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (e->deleted || e->attach_del || (e->env && e->env->changed))
+      return 1;
+    if (e->changed)
+      num_changed++;
+  }
+
+  if (num_changed == 0)
+    return 1;
+
+  /* Check they'll all fit, before writing anything */
+  fields = mutt_mem_calloc(num_changed * 2, sizeof(struct MboxStatusField));
+  for (int i = 0, j = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e->changed)
+      continue;
+
+    struct MboxStatusField *f = &fields[j++ * 2];
+    if (!mbox_find_status(adata->fp, e, &f[0], &f[1]))
+      goto done;
+
+    /* These match the values written by mutt_copy_header() */
+    snprintf(status, sizeof(status), "%s", e->read ? "RO" : e->old ? "O" : "");
+    snprintf(xstatus, sizeof(xstatus), "%s%s", e->replied ? "A" : "", e->flagged ? "F" : "");
+
+    if ((*status && (f[0].len < (int) strlen(status) + 1)) ||
+        (*xstatus && (f[1].len < (int) strlen(xstatus) + 1)))
+    {
+      goto done;
+    }
+
+    /* Don't leave an empty field behind */
+    if ((!*status && (f[0].len >= 0)) || (!*xstatus && (f[1].len >= 0)))
+      goto done;
+  }
+
+  mutt_debug(LL_DEBUG2, "updating %d emails in place\n", num_changed);
+  rc = -1;
+  for (int i = 0, j = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e->changed)
+      continue;
+
+    struct MboxStatusField *f = &fields[j++ * 2];
+    snprintf(status, sizeof(status), "%s", e->read ? "RO" : e->old ? "O" : "");
+    snprintf(xstatus, sizeof(xstatus), "%s%s", e->replied ? "A" : "", e->flagged ? "F" : "");
+
+    if ((mbox_write_status(adata->fp, &f[0], status) != 0) ||
+        (mbox_write_status(adata->fp, &f[1], xstatus) != 0))
+    {
+      goto done;
+    }
+  }
+
+  if (fflush(adata->fp) != 0)
+    goto done;
+
+  rc = 0;
+
+done:
+  FREE(&fields);
+  return rc;
+}
+
+/**
+ * mbox_copy_stream - Copy the rest of a file into the mailbox
+ * @param fp_in  File to copy from
+ * @param fp_out Mailbox file, at the place to copy to
+ * @retval  0 Success
+ * @retval -1 Error
+ *
+ * If possible, the kernel copies the data without passing it through NeoMutt.
+ */
+static int mbox_copy_stream(FILE *fp_in, FILE *fp_out)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+  struct stat st;
+  LOFF_T off_in = ftello(fp_in);
+  LOFF_T off_out = ftello(fp_out);
+
+  if ((off_in >= 0) && (off_out >= 0) && (fflush(fp_out) == 0) &&
+      (fstat(fileno(fp_in), &st) == 0))
+  {
+    while (off_in < st.st_size)
+    {
+      if (copy_file_range(fileno(fp_in), &off_in, fileno(fp_out), &off_out,
+                          st.st_size - off_in, 0) <= 0)
+      {
+        break;
+      }
+    }
+
+    /* Anything left over is copied the slow way */
+    if ((fseeko(fp_in, off_in, SEEK_SET) != 0) || (fseeko(fp_out, off_out, SEEK_SET) != 0))
+      return -1;
+  }
+#endif
+  return mutt_file_copy_stream(fp_in, fp_out);
+}
+
 /**
  * mbox_mbox_sync - Save changes to the Mailbox - Implements MxOps::mbox_sync()
  */
@@ -1222,6 +2211,41 @@ static int mbox_mbox_sync(struct Mailbox *m, int *index_hint)
     goto fatal;
   }
 
+  /* Changes to the flags can often be saved without moving any data */
+  if (stat(mailbox_path(m), &statbuf) == -1)
+  {
+    mutt_perror(mailbox_path(m));
+    goto bail;
+  }
+
+  i = mbox_sync_in_place(m);
+  if (i < 0)
+  {
+    mutt_perror(mailbox_path(m));
+    goto bail;
+  }
+  else if (i == 0)
+  {
+    mbox_unlock_mailbox(m);
+    mutt_sig_unblock();
+
+    /* Restore the previous access/modification times */
+    mbox_reset_atime(m, &statbuf);
+    mbox_remember_tail(m);
+#ifdef USE_HCACHE
+    mbox_hcache_invalidate(m);
+#endif
+
+    if (C_CheckMboxSize)
+    {
+      struct Mailbox *m_tmp = mailbox_find(mailbox_path(m));
+      if (m_tmp && !m_tmp->has_new)
+        mailbox_update(m_tmp);
+    }
+
+    return 0; /* signal success */
+  }
+
   /* Create a temporary file to write the new version of the mailbox in. */
   tempfile = mutt_buffer_pool_get();
   mutt_buffer_mktemp(tempfile);
@@ -1308,8 +2332,12 @@ static int mbox_mbox_sync(struct Mailbox *m, int *index_hint)
        * 'offset' in the real mailbox */
       new_offset[i - first].hdr = ftello(fp) + offset;
 
-      if (mutt_copy_message(fp, m, m->emails[i], MUTT_CM_UPDATE,
-                            CH_FROM | CH_UPDATE | CH_UPDATE_LEN, 0) != 0)
+      /* Leave room to update the flags in place, if they've changed before */
+      CopyHeaderFlags chflags = CH_FROM | CH_UPDATE | CH_UPDATE_LEN;
+      if (m->emails[i]->changed)
+        chflags |= CH_PAD_STATUS;
+
+      if (mutt_copy_message(fp, m, m->emails[i], MUTT_CM_UPDATE, chflags, 0) != 0)
       {
         mutt_perror(mutt_b2s(tempfile));
         goto bail;
@@ -1393,7 +2421,7 @@ static int mbox_mbox_sync(struct Mailbox *m, int *index_hint)
        * change/deleted message */
       if (!m->quiet)
         mutt_message(_("Committing changes..."));
-      i = mutt_file_copy_stream(fp, adata->fp);
+      i = mbox_copy_stream(fp, adata->fp);
 
       if (ferror(adata->fp))
         i = -1;
@@ -1451,6 +2479,10 @@ static int mbox_mbox_sync(struct Mailbox *m, int *index_hint)
     FREE(&old_offset);
     goto fatal;
   }
+  mbox_remember_tail(m);
+#ifdef USE_HCACHE
+  mbox_hcache_invalidate(m);
+#endif
 
   /* update the offsets of the rewritten messages */
   for (i = first, j = first; i < m->msg_count; i++)
@@ -1650,6 +2682,74 @@ static int mbox_msg_padding_size(struct Mailbox *m)
   return 1;
 }
 
+/**
+ * mbox_msg_save_hcache - Save message to the header cache - Implements MxOps::msg_save_hcache()
+ *
+ * The cached email is only replaced while it still matches the file, i.e.
+ * before the user has changed its flags.
+ */
+static int mbox_msg_save_hcache(struct Mailbox *m, struct Email *e)
+{
+  int rc = 0;
+#ifdef USE_HCACHE
+  if (e->changed || e->deleted || e->purge || e->attach_del)
+    return 0;
+
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  header_cache_t *hc = NULL;
+  if (adata && adata->hcache)
+    hc = adata->hcache;
+  else
+    hc = mbox_hcache_open(m);
+  if (!hc)
+    return 0;
+
+  char key[32];
+  int keylen = snprintf(key, sizeof(key), "/%d", e->index);
+  rc = mutt_hcache_store(hc, key, keylen, e, 0);
+  if (!adata || (hc != adata->hcache))
+    mutt_hcache_close(hc);
+#endif
+  return rc;
+}
+
+/**
+ * mbox_hcache_begin - Start a batch of header cache saves - Implements MxOps::hcache_begin()
+ */
+static int mbox_hcache_begin(struct Mailbox *m)
+{
+#ifdef USE_HCACHE
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata || adata->hcache)
+    return -1;
+
+  adata->hcache = mbox_hcache_open(m);
+  if (!adata->hcache)
+    return -1;
+
+  mutt_hcache_begin(adata->hcache);
+#endif
+  return 0;
+}
+
+/**
+ * mbox_hcache_commit - Finish a batch of header cache saves - Implements MxOps::hcache_commit()
+ */
+static int mbox_hcache_commit(struct Mailbox *m)
+{
+  int rc = 0;
+#ifdef USE_HCACHE
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata || !adata->hcache)
+    return -1;
+
+  rc = mutt_hcache_commit(adata->hcache);
+  mutt_hcache_close(adata->hcache);
+  adata->hcache = NULL;
+#endif
+  return rc;
+}
+
 /**
  * mbox_path_probe - Is this an mbox Mailbox? - Implements MxOps::path_probe()
  */
@@ -1862,7 +2962,9 @@ struct MxOps MxMboxOps = {
   .msg_commit       = mbox_msg_commit,
   .msg_close        = mbox_msg_close,
   .msg_padding_size = mbox_msg_padding_size,
-  .msg_save_hcache  = NULL,
+  .msg_save_hcache  = mbox_msg_save_hcache,
+  .hcache_begin     = mbox_hcache_begin,
+  .hcache_commit    = mbox_hcache_commit,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = mbox_path_probe,
@@ -1891,7 +2993,9 @@ struct MxOps MxMmdfOps = {
   .msg_commit       = mmdf_msg_commit,
   .msg_close        = mbox_msg_close,
   .msg_padding_size = mmdf_msg_padding_size,
-  .msg_save_hcache  = NULL,
+  .msg_save_hcache  = mbox_msg_save_hcache,
+  .hcache_begin     = mbox_hcache_begin,
+  .hcache_commit    = mbox_hcache_commit,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = mbox_path_probe,
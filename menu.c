@@ -114,10 +114,11 @@ static int get_color(int index, unsigned char *s)
       return Colors->defs[type];
   }
 
+  struct PatternCache cache = { 0 };
   STAILQ_FOREACH(np, color, entries)
   {
     if (mutt_pattern_exec(SLIST_FIRST(np->color_pattern),
-                          MUTT_MATCH_FULL_ADDRESS, Context->mailbox, e, NULL))
+                          MUTT_MATCH_FULL_ADDRESS, Context->mailbox, e, &cache))
       return np->pair;
   }
 
@@ -611,3 +611,196 @@ bool mutt_regex_match(const struct Regex *regex, const char *str)
 {
   return mutt_regex_capture(regex, str, 0, NULL);
 }
+
+/**
+ * regex_skip_bracket - Skip over a bracket expression
+ * @param p Regex, just after the '['
+ * @retval ptr  Character after the closing ']'
+ * @retval NULL The bracket expression isn't closed
+ */
+static const char *regex_skip_bracket(const char *p)
+{
+  if (*p == '^')
+    p++;
+  if (*p == ']')
+    p++;
+
+  while (*p)
+  {
+    if ((p[0] == '[') && ((p[1] == ':') || (p[1] == '=') || (p[1] == '.')))
+    {
+      const char end[3] = { p[1], ']', '\0' };
+      p = strstr(p + 2, end);
+      if (!p)
+        return NULL;
+      p += 2;
+    }
+    else if (*p == ']')
+      return p + 1;
+    else
+      p++;
+  }
+
+  return NULL;
+}
+
+/**
+ * regex_skip_group - Skip over a parenthesised group
+ * @param p Regex, just after the '('
+ * @retval ptr  Character after the closing ')'
+ * @retval NULL The group isn't closed
+ */
+static const char *regex_skip_group(const char *p)
+{
+  int depth = 1;
+
+  while (*p)
+  {
+    switch (*p)
+    {
+      case '\\':
+        if (!p[1])
+          return NULL;
+        p += 2;
+        break;
+      case '[':
+        p = regex_skip_bracket(p + 1);
+        if (!p)
+          return NULL;
+        break;
+      case '(':
+        depth++;
+        p++;
+        break;
+      case ')':
+        p++;
+        if (--depth == 0)
+          return p;
+        break;
+      default:
+        p++;
+        break;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * mutt_regex_literal - Find some text that every match of a regex contains
+ * @param pattern Extended regex
+ * @param icase   true if the regex ignores case
+ * @retval ptr  Literal text, lower case if icase is set
+ * @retval NULL No literal text was found
+ *
+ * This is deliberately simple: the longest run of plain ASCII characters at
+ * the top level of the regex is used.  Groups, bracket expressions and
+ * anything unusual end the run; alternation gives up completely.
+ *
+ * The caller must free the returned string.
+ */
+char *mutt_regex_literal(const char *pattern, bool icase)
+{
+  if (!pattern)
+    return NULL;
+
+  const size_t plen = mutt_str_strlen(pattern);
+  char *cur = mutt_mem_malloc(plen + 1);
+  char *best = mutt_mem_malloc(plen + 1);
+  size_t cur_len = 0;
+  size_t best_len = 0;
+  const char *p = pattern;
+
+  while (*p)
+  {
+    char ch = '\0'; // The literal character matched by this atom
+
+    switch (*p)
+    {
+      case '|':
+      case ')':
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+        goto fail;
+      case '(':
+        p = regex_skip_group(p + 1);
+        if (!p)
+          goto fail;
+        break;
+      case '[':
+        p = regex_skip_bracket(p + 1);
+        if (!p)
+          goto fail;
+        break;
+      case '\\':
+        p++;
+        if (!*p)
+          goto fail;
+        /* Letters and digits are classes, anchors or back-references */
+        if (!isalnum((unsigned char) *p) && ((unsigned char) *p < 0x80) &&
+            !strchr("<>`'", *p))
+        {
+          ch = *p;
+        }
+        p++;
+        break;
+      case '.':
+      case '^':
+      case '$':
+        p++;
+        break;
+      default:
+        if ((unsigned char) *p < 0x80)
+          ch = *p;
+        p++;
+        break;
+    }
+
+    bool optional = false;
+    bool repeated = false;
+    while ((*p == '*') || (*p == '+') || (*p == '?') || (*p == '{'))
+    {
+      if ((*p == '*') || (*p == '?'))
+        optional = true;
+      if (*p == '{')
+      {
+        if (!isdigit((unsigned char) p[1]) || (atoi(p + 1) == 0))
+          optional = true;
+        p = strchr(p, '}');
+        if (!p)
+          goto fail;
+      }
+      repeated = true;
+      p++;
+    }
+
+    if ((ch != '\0') && !optional)
+      cur[cur_len++] = icase ? tolower((unsigned char) ch) : ch;
+
+    if ((ch == '\0') || repeated || (*p == '\0'))
+    {
+      if (cur_len > best_len)
+      {
+        memcpy(best, cur, cur_len);
+        best_len = cur_len;
+      }
+      cur_len = 0;
+    }
+  }
+
+  FREE(&cur);
+  if (best_len == 0)
+  {
+    FREE(&best);
+    return NULL;
+  }
+  best[best_len] = '\0';
+  return best;
+
+fail:
+  FREE(&cur);
+  FREE(&best);
+  return NULL;
+}
@@ -102,5 +102,6 @@ int             mutt_replacelist_remove(struct ReplaceList *rl, const char *pat)
 
 bool mutt_regex_match  (const struct Regex *regex, const char *str);
 bool mutt_regex_capture(const struct Regex *regex, const char *str, size_t num, regmatch_t matches[]);
+char *mutt_regex_literal(const char *pattern, bool icase);
 
 #endif /* MUTT_LIB_REGEX_H */
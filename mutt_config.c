@@ -78,6 +78,7 @@
 #include "hcache/lib.h"
 #include "imap/lib.h"
 #include "maildir/lib.h"
+#include "mbox/lib.h"
 #include "ncrypt/lib.h"
 #include "nntp/lib.h"
 #include "notmuch/lib.h"
@@ -2154,6 +2155,16 @@ struct ConfigDef MuttVars[] = {
   ** .pp
   ** Also see the $$move variable.
   */
+#ifdef USE_HCACHE
+  { "mbox_header_cache", DT_BOOL, &C_MboxHeaderCache, false },
+  /*
+  ** .pp
+  ** If \fIset\fP, and $$header_cache is set, NeoMutt will store the headers of
+  ** mbox folders in the header cache.  When the folder is opened again, and
+  ** it hasn't been changed, or mail has only been appended to it, the cached
+  ** headers are used and only the new messages are read.
+  */
+#endif
   { "mbox_type", DT_ENUM, &C_MboxType, MUTT_MBOX, IP &MagicDef },
   /*
   ** .pp
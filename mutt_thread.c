@@ -166,28 +166,24 @@ static void linearize_tree(struct Context *ctx)
  * nodes, whether a node itself is visible, whether, if invisible, it has
  * depth anyway, and whether any of its later siblings are roots of visible
  * subtrees.  while it's at it, it frees the old thread display, so we can
- * skip parts of the tree in mutt_draw_tree() if we've decided here that we
+ * skip parts of the tree in draw_thread() if we've decided here that we
  * don't care about them any more.
  */
-static void calculate_visibility(struct Context *ctx, int *max_depth)
+static void calculate_visibility(struct Context *ctx)
 {
   struct MuttThread *tmp = NULL;
   struct MuttThread *tree = ctx->tree;
   int hide_top_missing = C_HideTopMissing && !C_HideMissing;
   int hide_top_limited = C_HideTopLimited && !C_HideLimited;
-  int depth = 0;
 
   /* we walk each level backwards to make it easier to compute next_subtree_visible */
   while (tree->next)
     tree = tree->next;
-  *max_depth = 0;
 
   while (true)
   {
-    if (depth > *max_depth)
-      *max_depth = depth;
-
     tree->subtree_visible = 0;
+    tree->tree_drawn = false;
     if (tree->message)
     {
       FREE(&tree->message->tree);
@@ -223,7 +219,6 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
         tree->next && (tree->next->next_subtree_visible || tree->next->subtree_visible);
     if (tree->child)
     {
-      depth++;
       tree = tree->child;
       while (tree->next)
         tree = tree->next;
@@ -233,10 +228,7 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
     else
     {
       while (tree && !tree->prev)
-      {
-        depth--;
         tree = tree->parent;
-      }
       if (!tree)
         break;
       tree = tree->prev;
@@ -271,8 +263,41 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
 }
 
 /**
- * mutt_draw_tree - Draw a tree of threaded emails
- * @param ctx Mailbox
+ * thread_depth - Find the depth of a thread
+ * @param top Top-level node of the thread
+ * @retval num Depth of the deepest node, counting every level
+ */
+static int thread_depth(struct MuttThread *top)
+{
+  struct MuttThread *tree = top;
+  int depth = 0, max_depth = 0;
+
+  while (true)
+  {
+    if (depth > max_depth)
+      max_depth = depth;
+    if (tree->child)
+    {
+      tree = tree->child;
+      depth++;
+      continue;
+    }
+    while ((tree != top) && !tree->next)
+    {
+      tree = tree->parent;
+      depth--;
+    }
+    if (tree == top)
+      break;
+    tree = tree->next;
+  }
+
+  return max_depth;
+}
+
+/**
+ * draw_thread - Draw the tree of one thread
+ * @param top Top-level node of the thread
  *
  * Since the graphics characters have a value >255, I have to resort to using
  * escape sequences to pass the information to print_enriched_string().  These
@@ -282,18 +307,17 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
  * graphics chars on terminals which don't support them (see the man page for
  * curs_addch).
  */
-void mutt_draw_tree(struct Context *ctx)
+static void draw_thread(struct MuttThread *top)
 {
   char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *new_tree = NULL;
   enum TreeChar corner = (C_Sort & SORT_REVERSE) ? MUTT_TREE_ULCORNER : MUTT_TREE_LLCORNER;
   enum TreeChar vtee = (C_Sort & SORT_REVERSE) ? MUTT_TREE_BTEE : MUTT_TREE_TTEE;
-  int depth = 0, start_depth = 0, max_depth = 0, width = C_NarrowTree ? 1 : 2;
+  int depth = 0, start_depth = 0, width = C_NarrowTree ? 1 : 2;
+  int max_depth = thread_depth(top);
   struct MuttThread *nextdisp = NULL, *pseudo = NULL, *parent = NULL;
-  struct MuttThread *tree = ctx->tree;
+  struct MuttThread *tree = top;
 
-  /* Do the visibility calculations and free the old thread chars.
-   * From now on we can simply ignore invisible subtrees */
-  calculate_visibility(ctx, &max_depth);
+  top->tree_drawn = true;
   pfx = mutt_mem_malloc((width * max_depth) + 2);
   arrow = mutt_mem_malloc((width * max_depth) + 2);
   while (tree)
@@ -374,6 +398,11 @@ void mutt_draw_tree(struct Context *ctx)
             depth--;
           }
         }
+        if (tree == top)
+        {
+          tree = NULL;
+          break;
+        }
         if (tree == pseudo)
           pseudo = NULL;
         if (tree == nextdisp)
@@ -395,6 +424,39 @@ void mutt_draw_tree(struct Context *ctx)
   FREE(&arrow);
 }
 
+/**
+ * mutt_draw_tree - Prepare a tree of threaded emails for drawing
+ * @param ctx Mailbox
+ *
+ * This only does the visibility calculations and frees the old thread chars.
+ * The thread chars of a thread are drawn when one of its emails is displayed,
+ * see mutt_draw_thread_tree().
+ */
+void mutt_draw_tree(struct Context *ctx)
+{
+  calculate_visibility(ctx);
+}
+
+/**
+ * mutt_draw_thread_tree - Draw the tree of the thread containing an email
+ * @param e Email
+ *
+ * The thread chars of the whole thread are drawn, and kept, until the tree
+ * changes and mutt_draw_tree() is called again.
+ */
+void mutt_draw_thread_tree(struct Email *e)
+{
+  if (!e || !e->thread)
+    return;
+
+  struct MuttThread *top = e->thread;
+  while (top->parent)
+    top = top->parent;
+
+  if (!top->tree_drawn)
+    draw_thread(top);
+}
+
 /**
  * make_subject_list - Create a sorted list of all subjects in a thread
  * @param[out] subjects String List of subjects
@@ -620,6 +682,57 @@ void mutt_clear_threads(struct Context *ctx)
   mutt_hash_free(&ctx->thread_hash);
 }
 
+/**
+ * mutt_threads_valid - Can the threads be updated, rather than rebuilt?
+ * @param ctx Mailbox
+ * @retval true Every message in the thread tree is still in the Mailbox
+ *
+ * If mail has only been added, the new Emails can be linked into the existing
+ * tree, see mutt_sort_threads().
+ */
+bool mutt_threads_valid(struct Context *ctx)
+{
+  if (!ctx || !ctx->mailbox || !ctx->tree || !ctx->thread_hash)
+    return false;
+
+  struct Mailbox *m = ctx->mailbox;
+  size_t threaded = 0;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (!e->thread)
+      continue;
+    if (e->thread->message != e)
+      return false;
+    threaded++;
+  }
+
+  /* Any other message in the tree must have been freed */
+  size_t in_tree = 0;
+  struct MuttThread *thread = ctx->tree;
+  while (thread)
+  {
+    if (thread->message)
+      in_tree++;
+
+    if (thread->child)
+    {
+      thread = thread->child;
+      continue;
+    }
+
+    while (thread && !thread->next)
+      thread = thread->parent;
+    if (thread)
+      thread = thread->next;
+  }
+
+  return threaded == in_tree;
+}
+
 /**
  * compare_threads - Sorting function for email threads
  * @param a First thread to compare
@@ -1219,7 +1332,8 @@ void mutt_set_vnum(struct Context *ctx)
       m->v2r[m->vcount] = i;
       m->vcount++;
       ctx->vsize += e->content->length + e->content->offset - e->content->hdr_offset + padding;
-      e->num_hidden = mutt_get_hidden(ctx, e);
+      /* num_hidden is only used for collapsed threads */
+      e->num_hidden = e->collapsed ? mutt_get_hidden(ctx, e) : 0;
     }
   }
 }
@@ -1488,6 +1602,7 @@ static bool link_threads(struct Email *parent, struct Email *child, struct Mailb
 
   child->changed = true;
   child->env->changed |= MUTT_ENV_CHANGED_IRT;
+  FREE(&child->pattern_memo);
   return true;
 }
 
@@ -68,6 +68,7 @@ int mutt_aside_thread(struct Email *e, bool forwards, bool subthreads);
 #define mutt_previous_subthread(e) mutt_aside_thread(e, false, true)
 
 void               mutt_clear_threads     (struct Context *ctx);
+void               mutt_draw_thread_tree  (struct Email *e);
 void               mutt_draw_tree         (struct Context *ctx);
 bool               mutt_link_threads      (struct Email *parent, struct EmailList *children, struct Mailbox *m);
 struct Hash *      mutt_make_id_hash      (struct Mailbox *m);
@@ -76,5 +77,6 @@ int                mutt_parent_message    (struct Context *ctx, struct Email *e,
 void               mutt_set_vnum          (struct Context *ctx);
 struct MuttThread *mutt_sort_subthreads   (struct MuttThread *thread, bool init);
 void               mutt_sort_threads      (struct Context *ctx, bool init);
+bool               mutt_threads_valid     (struct Context *ctx);
 
 #endif /* MUTT_MUTT_THREAD_H */
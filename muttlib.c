@@ -863,6 +863,416 @@ void mutt_safe_path(struct Buffer *dest, const struct Address *a)
       *p = '_';
 }
 
+/**
+ * enum FormatNodeType - Type of a piece of a parsed format string
+ */
+enum FormatNodeType
+{
+  FMT_END,     ///< End of the string, or a bad format
+  FMT_TEXT,    ///< Plain text
+  FMT_CHAR,    ///< One escaped character, e.g. "\n" or "%%"
+  FMT_EXPANDO, ///< Expando, e.g. "%-20.20s", expanded by the callback
+  FMT_PAD,     ///< Padding, e.g. "%>-"
+};
+
+/**
+ * struct FormatNode - A piece of a parsed format string
+ */
+struct FormatNode
+{
+  enum FormatNodeType type; ///< Type of the piece
+  char op;                  ///< Expando, padding or escaped character
+  bool optional;            ///< Expando is a conditional, e.g. "%<x?y&z>"
+  bool to_lower;            ///< Lower-case the expansion, "%_x"
+  bool no_dots;             ///< Replace the dots in the expansion, "%:x"
+  size_t start;             ///< Offset of the text, or of the padding character
+  size_t next;              ///< Offset of the rest of the format string
+  size_t len;               ///< Length of the text, or of the padding character
+  int width;                ///< Screen width of the text, or of the padding character
+  char *prefix;             ///< Field precision, e.g. "-20.20"
+  char *if_str;             ///< Conditional: string to display if true
+  char *else_str;           ///< Conditional: string to display if false
+};
+
+/**
+ * struct FormatProgram - A parsed format string
+ *
+ * A piece of the string is parsed the first time it's reached, and kept,
+ * indexed by its offset.  The callback of an expando may consume more of the
+ * string, so it decides where the next piece starts.
+ */
+struct FormatProgram
+{
+  char *fmt;                 ///< Format string
+  char *src;                 ///< Copy of the format string, rewritten by the parser
+  size_t size;               ///< Size of src and of nodes
+  struct FormatNode **nodes; ///< Parsed pieces, indexed by their offset in src
+  int busy;                  ///< Number of expansions using the program
+  bool cached;               ///< Program is in FormatCache
+};
+
+#define FORMAT_CACHE_SIZE 32
+
+static struct FormatProgram *FormatCache[FORMAT_CACHE_SIZE]; ///< Recently used format strings
+static size_t FormatCacheNext = 0; ///< Next slot of FormatCache to reuse
+
+/**
+ * format_program_new - Create a FormatProgram
+ * @param fmt Format string
+ * @retval ptr New FormatProgram
+ */
+static struct FormatProgram *format_program_new(const char *fmt)
+{
+  struct FormatProgram *prog = mutt_mem_calloc(1, sizeof(struct FormatProgram));
+  const size_t len = mutt_str_strlen(fmt);
+
+  prog->fmt = mutt_str_strdup(fmt);
+  /* rewriting "%?" as "%<" may escape every character */
+  prog->size = (3 * len) + 1;
+  prog->src = mutt_mem_calloc(prog->size, 1);
+  memcpy(prog->src, fmt, len);
+  prog->nodes = mutt_mem_calloc(prog->size, sizeof(struct FormatNode *));
+  return prog;
+}
+
+/**
+ * format_program_free - Free a FormatProgram
+ * @param[out] ptr FormatProgram to free
+ */
+static void format_program_free(struct FormatProgram **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct FormatProgram *prog = *ptr;
+  for (size_t i = 0; i < prog->size; i++)
+  {
+    struct FormatNode *node = prog->nodes[i];
+    if (!node)
+      continue;
+    FREE(&node->prefix);
+    FREE(&node->if_str);
+    FREE(&node->else_str);
+    FREE(&node);
+  }
+  FREE(&prog->nodes);
+  FREE(&prog->src);
+  FREE(&prog->fmt);
+  FREE(ptr);
+}
+
+/**
+ * format_program_get - Get the parsed form of a format string
+ * @param fmt Format string
+ * @retval ptr FormatProgram, release it with format_program_release()
+ *
+ * The programs of recently used strings are kept in a small cache.  Programs
+ * in use aren't evicted: expansions can nest.
+ */
+static struct FormatProgram *format_program_get(const char *fmt)
+{
+  struct FormatProgram *prog = NULL;
+
+  for (size_t i = 0; i < FORMAT_CACHE_SIZE; i++)
+  {
+    if (FormatCache[i] && (mutt_str_strcmp(FormatCache[i]->fmt, fmt) == 0))
+    {
+      prog = FormatCache[i];
+      prog->busy++;
+      return prog;
+    }
+  }
+
+  prog = format_program_new(fmt);
+  for (size_t i = 0; i < FORMAT_CACHE_SIZE; i++)
+  {
+    const size_t slot = (FormatCacheNext + i) % FORMAT_CACHE_SIZE;
+    if (FormatCache[slot] && FormatCache[slot]->busy)
+      continue;
+
+    format_program_free(&FormatCache[slot]);
+    FormatCache[slot] = prog;
+    FormatCacheNext = (slot + 1) % FORMAT_CACHE_SIZE;
+    prog->cached = true;
+    break;
+  }
+
+  prog->busy++;
+  return prog;
+}
+
+/**
+ * format_program_release - Finish using a FormatProgram
+ * @param prog FormatProgram
+ */
+static void format_program_release(struct FormatProgram *prog)
+{
+  prog->busy--;
+  if (!prog->cached && (prog->busy == 0))
+    format_program_free(&prog);
+}
+
+/**
+ * mutt_expando_cleanup - Free the cache of parsed format strings
+ */
+void mutt_expando_cleanup(void)
+{
+  for (size_t i = 0; i < FORMAT_CACHE_SIZE; i++)
+    format_program_free(&FormatCache[i]);
+}
+
+/**
+ * format_parse_cond - Parse one branch of a conditional expando
+ * @param[out] buf       Buffer for the branch
+ * @param[in]  buflen    Length of the buffer
+ * @param[in]  src       Format string, at the start of the branch
+ * @param[out] lrbalance Nesting depth of the conditional
+ * @retval ptr Rest of the format string
+ */
+static char *format_parse_cond(char *buf, size_t buflen, char *src, int *lrbalance)
+{
+  char *cp = buf;
+  size_t count = 0;
+
+  while ((*lrbalance > 0) && (count < buflen) && *src)
+  {
+    if ((src[0] == '%') && (src[1] == '>'))
+    {
+      /* This is a padding expando; copy two chars and carry on */
+      *cp++ = *src++;
+      *cp++ = *src++;
+      count += 2;
+      continue;
+    }
+
+    if (*src == '\\')
+    {
+      src++;
+      *cp++ = *src++;
+    }
+    else if ((src[0] == '%') && (src[1] == '<'))
+    {
+      (*lrbalance)++;
+    }
+    else if (src[0] == '>')
+    {
+      (*lrbalance)--;
+    }
+    if (*lrbalance == 0)
+      break;
+    if ((*lrbalance == 1) && (src[0] == '&'))
+      break;
+    *cp++ = *src++;
+    count++;
+  }
+  *cp = '\0';
+
+  return src;
+}
+
+/**
+ * format_parse - Parse a piece of a format string
+ * @param prog FormatProgram
+ * @param off  Offset of the piece in the format string
+ * @retval ptr Parsed piece, owned by the FormatProgram
+ */
+static struct FormatNode *format_parse(struct FormatProgram *prog, size_t off)
+{
+  struct FormatNode *node = mutt_mem_calloc(1, sizeof(struct FormatNode));
+  prog->nodes[off] = node;
+
+  char *src = prog->src + off;
+  node->type = FMT_END;
+
+  if (*src == '\0')
+    return node;
+
+  if (*src == '\\')
+  {
+    if (!*++src)
+      return node;
+    switch (*src)
+    {
+      case 'f':
+        node->op = '\f';
+        break;
+      case 'n':
+        node->op = '\n';
+        break;
+      case 'r':
+        node->op = '\r';
+        break;
+      case 't':
+        node->op = '\t';
+        break;
+      case 'v':
+        node->op = '\v';
+        break;
+      default:
+        node->op = *src;
+        break;
+    }
+    node->type = FMT_CHAR;
+    node->next = src + 1 - prog->src;
+    return node;
+  }
+
+  if (*src != '%')
+  {
+    while (*src && (*src != '%') && (*src != '\\'))
+    {
+      int width;
+      int bytes = mutt_mb_charlen(src, &width);
+      if (bytes < 0)
+      {
+        bytes = 1;
+        width = 1;
+      }
+      src += bytes;
+      node->width += width;
+    }
+    node->type = FMT_TEXT;
+    node->start = off;
+    node->len = src - prog->src - off;
+    node->next = src - prog->src;
+    return node;
+  }
+
+  if (*++src == '%')
+  {
+    node->type = FMT_CHAR;
+    node->op = '%';
+    node->next = src + 1 - prog->src;
+    return node;
+  }
+
+  if (*src == '?')
+  {
+    /* change original %? to new %< notation */
+    /* %?x?y&z? to %<x?y&z> where y and z are nestable */
+    char *p = src;
+    *p = '<';
+    /* skip over "x" */
+    for (; *p && *p != '?'; p++)
+      ;
+    /* nothing */
+    if (*p == '?')
+      p++;
+    /* fix up the "y&z" section */
+    for (; *p && *p != '?'; p++)
+    {
+      /* escape '<' and '>' to work inside nested-if */
+      if ((*p == '<') || (*p == '>'))
+      {
+        memmove(p + 2, p, mutt_str_strlen(p) + 1);
+        *p++ = '\\';
+        *p++ = '\\';
+      }
+    }
+    if (*p == '?')
+      *p = '>';
+  }
+
+  char prefix[128], if_str[128], else_str[128];
+  char ch;
+  char *cp = NULL;
+  size_t count;
+
+  prefix[0] = '\0';
+  if_str[0] = '\0';
+  else_str[0] = '\0';
+
+  if (*src == '<')
+  {
+    node->optional = true;
+    ch = *(++src); /* save the character to switch on */
+    src++;
+    cp = prefix;
+    count = 0;
+    while ((count < sizeof(prefix) - 1) && (*src != '?'))
+    {
+      *cp++ = *src++;
+      count++;
+    }
+    *cp = '\0';
+  }
+  else
+  {
+    /* eat the format string */
+    cp = prefix;
+    count = 0;
+    while ((count < sizeof(prefix) - 1) && (isdigit((unsigned char) *src) || (*src == '.') ||
+                                            (*src == '-') || (*src == '=')))
+    {
+      *cp++ = *src++;
+      count++;
+    }
+    *cp = '\0';
+
+    if (!*src)
+      return node; /* bad format */
+
+    ch = *src++; /* save the character to switch on */
+  }
+
+  if (node->optional)
+  {
+    if (*src != '?')
+      return node; /* bad format */
+    src++;
+
+    /* eat the 'if' part of the string */
+    int lrbalance = 1;
+    src = format_parse_cond(if_str, sizeof(if_str) - 2, src, &lrbalance);
+
+    /* eat the 'else' part of the string (optional) */
+    if (*src == '&')
+      src++; /* skip the & */
+    src = format_parse_cond(else_str, sizeof(else_str) - 2, src, &lrbalance);
+
+    if (!*src)
+      return node; /* bad format */
+
+    src++; /* move past the trailing '>' (formerly '?') */
+  }
+
+  if ((ch == '>') || (ch == '*') || (ch == '|'))
+  {
+    /* the padding character */
+    int pw;
+    int pl = mutt_mb_charlen(src, &pw);
+    if (pl <= 0)
+    {
+      pl = 1;
+      pw = 1;
+    }
+    node->type = FMT_PAD;
+    node->op = ch;
+    node->start = src - prog->src;
+    node->len = pl;
+    node->width = pw;
+    return node;
+  }
+
+  while ((ch == '_') || (ch == ':'))
+  {
+    if (ch == '_')
+      node->to_lower = true;
+    else if (ch == ':')
+      node->no_dots = true;
+
+    ch = *src++;
+  }
+
+  node->type = FMT_EXPANDO;
+  node->op = ch;
+  node->next = src - prog->src;
+  node->prefix = mutt_str_strdup(prefix);
+  node->if_str = mutt_str_strdup(if_str);
+  node->else_str = mutt_str_strdup(else_str);
+  return node;
+}
+
 /**
  * mutt_expando_format - Expand expandos (%x) in a string
  * @param[out] buf      Buffer in which to save string
@@ -877,19 +1287,12 @@ void mutt_safe_path(struct Buffer *dest, const struct Address *a)
 void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const char *src,
                          format_t *callback, unsigned long data, MuttFormatFlags flags)
 {
-  char prefix[128], tmp[1024];
-  char *cp = NULL, *wptr = buf;
-  char ch;
-  char if_str[128], else_str[128];
-  size_t wlen, count, len, wid;
+  char tmp[1024];
+  char *wptr = buf;
+  size_t wlen, len, wid;
   FILE *fp_filter = NULL;
   char *recycler = NULL;
 
-  char src2[256];
-  mutt_str_strfcpy(src2, src, mutt_str_strlen(src) + 1);
-  src = src2;
-
-  prefix[0] = '\0';
   buflen--; /* save room for the terminal \0 */
   wlen = ((flags & MUTT_FORMAT_ARROWCURSOR) && C_ArrowCursor) ?
              mutt_strwidth(C_ArrowString) + 1 :
@@ -1026,371 +1429,199 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
     }
   }
 
-  while (*src && (wlen < buflen))
+  struct FormatProgram *prog = format_program_get(src);
+  size_t off = 0;
+
+  while (wlen < buflen)
   {
-    if (*src == '%')
+    struct FormatNode *node = prog->nodes[off];
+    if (!node)
+      node = format_parse(prog, off);
+
+    if (node->type == FMT_END)
+      break;
+
+    if (node->type == FMT_TEXT)
     {
-      if (*++src == '%')
+      src = prog->src + node->start;
+      if ((wlen + node->len) < buflen)
       {
-        *wptr++ = '%';
-        wlen++;
-        col++;
-        src++;
+        memcpy(wptr, src, node->len);
+        wptr += node->len;
+        wlen += node->len;
+        col += node->width;
+        off = node->next;
         continue;
       }
 
-      if (*src == '?')
+      /* not enough room: copy what fits */
+      const char *end = src + node->len;
+      while (src < end)
       {
-        /* change original %? to new %< notation */
-        /* %?x?y&z? to %<x?y&z> where y and z are nestable */
-        char *p = (char *) src;
-        *p = '<';
-        /* skip over "x" */
-        for (; *p && *p != '?'; p++)
-          ;
-        /* nothing */
-        if (*p == '?')
-          p++;
-        /* fix up the "y&z" section */
-        for (; *p && *p != '?'; p++)
+        int bytes, width;
+        /* in case of error, simply copy byte */
+        bytes = mutt_mb_charlen(src, &width);
+        if (bytes < 0)
         {
-          /* escape '<' and '>' to work inside nested-if */
-          if ((*p == '<') || (*p == '>'))
-          {
-            memmove(p + 2, p, mutt_str_strlen(p) + 1);
-            *p++ = '\\';
-            *p++ = '\\';
-          }
+          bytes = 1;
+          width = 1;
         }
-        if (*p == '?')
-          *p = '>';
-      }
-
-      if (*src == '<')
-      {
-        flags |= MUTT_FORMAT_OPTIONAL;
-        ch = *(++src); /* save the character to switch on */
-        src++;
-        cp = prefix;
-        count = 0;
-        while ((count < sizeof(prefix)) && (*src != '?'))
-        {
-          *cp++ = *src++;
-          count++;
-        }
-        *cp = '\0';
+        if ((wlen + bytes) >= buflen)
+          break;
+        memcpy(wptr, src, bytes);
+        wptr += bytes;
+        src += bytes;
+        wlen += bytes;
+        col += width;
       }
-      else
-      {
-        flags &= ~MUTT_FORMAT_OPTIONAL;
-
-        /* eat the format string */
-        cp = prefix;
-        count = 0;
-        while ((count < sizeof(prefix)) && (isdigit((unsigned char) *src) || (*src == '.') ||
-                                            (*src == '-') || (*src == '=')))
-        {
-          *cp++ = *src++;
-          count++;
-        }
-        *cp = '\0';
+      wlen = buflen;
+      break;
+    }
 
-        if (!*src)
-          break; /* bad format */
+    if (node->type == FMT_CHAR)
+    {
+      *wptr++ = node->op;
+      wlen++;
+      col++;
+      off = node->next;
+      continue;
+    }
 
-        ch = *src++; /* save the character to switch on */
-      }
+    if (node->optional)
+      flags |= MUTT_FORMAT_OPTIONAL;
+    else
+      flags &= ~MUTT_FORMAT_OPTIONAL;
 
-      if (flags & MUTT_FORMAT_OPTIONAL)
+    if (node->type == FMT_EXPANDO)
+    {
+      /* use callback function to handle this case */
+      const char *next =
+          callback(tmp, sizeof(tmp), col, cols, node->op, prog->src + node->next,
+                   NONULL(node->prefix), NONULL(node->if_str),
+                   NONULL(node->else_str), data, flags);
+
+      if (node->to_lower)
+        mutt_str_strlower(tmp);
+      if (node->no_dots)
       {
-        int lrbalance;
-
-        if (*src != '?')
-          break; /* bad format */
-        src++;
-
-        /* eat the 'if' part of the string */
-        cp = if_str;
-        count = 0;
-        lrbalance = 1;
-        while ((lrbalance > 0) && (count < sizeof(if_str)) && *src)
-        {
-          if ((src[0] == '%') && (src[1] == '>'))
-          {
-            /* This is a padding expando; copy two chars and carry on */
-            *cp++ = *src++;
-            *cp++ = *src++;
-            count += 2;
-            continue;
-          }
+        char *p = tmp;
+        for (; *p; p++)
+          if (*p == '.')
+            *p = '_';
+      }
 
-          if (*src == '\\')
-          {
-            src++;
-            *cp++ = *src++;
-          }
-          else if ((src[0] == '%') && (src[1] == '<'))
-          {
-            lrbalance++;
-          }
-          else if (src[0] == '>')
-          {
-            lrbalance--;
-          }
-          if (lrbalance == 0)
-            break;
-          if ((lrbalance == 1) && (src[0] == '&'))
-            break;
-          *cp++ = *src++;
-          count++;
-        }
-        *cp = '\0';
-
-        /* eat the 'else' part of the string (optional) */
-        if (*src == '&')
-          src++; /* skip the & */
-        cp = else_str;
-        count = 0;
-        while ((lrbalance > 0) && (count < sizeof(else_str)) && *src)
-        {
-          if ((src[0] == '%') && (src[1] == '>'))
-          {
-            /* This is a padding expando; copy two chars and carry on */
-            *cp++ = *src++;
-            *cp++ = *src++;
-            count += 2;
-            continue;
-          }
+      len = mutt_str_strlen(tmp);
+      if ((len + wlen) > buflen)
+        len = mutt_wstr_trunc(tmp, buflen - wlen, cols - col, NULL);
 
-          if (*src == '\\')
-          {
-            src++;
-            *cp++ = *src++;
-          }
-          else if ((src[0] == '%') && (src[1] == '<'))
-          {
-            lrbalance++;
-          }
-          else if (src[0] == '>')
-          {
-            lrbalance--;
-          }
-          if (lrbalance == 0)
-            break;
-          if ((lrbalance == 1) && (src[0] == '&'))
-            break;
-          *cp++ = *src++;
-          count++;
-        }
-        *cp = '\0';
+      memcpy(wptr, tmp, len);
+      wptr += len;
+      wlen += len;
+      col += mutt_strwidth(tmp);
 
-        if (!*src)
-          break; /* bad format */
+      if (!next || (next < prog->src) || (next > (prog->src + mutt_str_strlen(prog->src))))
+        break;
+      off = next - prog->src;
+      continue;
+    }
 
-        src++; /* move past the trailing '>' (formerly '?') */
-      }
+    /* FMT_PAD */
+    src = prog->src + node->start;
+    const int pl = node->len;
+    const int pw = node->width;
+    if ((node->op == '>') || (node->op == '*'))
+    {
+      /* %>X: right justify to EOL, left takes precedence
+       * %*X: right justify to EOL, right takes precedence */
+      int soft = node->op == '*';
 
-      /* handle generic cases first */
-      if ((ch == '>') || (ch == '*'))
+      /* see if there's room to add content, else ignore */
+      if (((col < cols) && (wlen < buflen)) || soft)
       {
-        /* %>X: right justify to EOL, left takes precedence
-         * %*X: right justify to EOL, right takes precedence */
-        int soft = ch == '*';
-        int pl, pw;
-        pl = mutt_mb_charlen(src, &pw);
-        if (pl <= 0)
-        {
-          pl = 1;
-          pw = 1;
-        }
-
-        /* see if there's room to add content, else ignore */
-        if (((col < cols) && (wlen < buflen)) || soft)
-        {
-          int pad;
+        int pad;
 
-          /* get contents after padding */
-          mutt_expando_format(tmp, sizeof(tmp), 0, cols, src + pl, callback, data, flags);
-          len = mutt_str_strlen(tmp);
-          wid = mutt_strwidth(tmp);
+        /* get contents after padding */
+        mutt_expando_format(tmp, sizeof(tmp), 0, cols, src + pl, callback, data, flags);
+        len = mutt_str_strlen(tmp);
+        wid = mutt_strwidth(tmp);
 
-          pad = (cols - col - wid) / pw;
-          if (pad >= 0)
-          {
-            /* try to consume as many columns as we can, if we don't have
-             * memory for that, use as much memory as possible */
-            if (wlen + (pad * pl) + len > buflen)
-              pad = (buflen > (wlen + len)) ? ((buflen - wlen - len) / pl) : 0;
-            else
-            {
-              /* Add pre-spacing to make multi-column pad characters and
-               * the contents after padding line up */
-              while ((col + (pad * pw) + wid < cols) && (wlen + (pad * pl) + len < buflen))
-              {
-                *wptr++ = ' ';
-                wlen++;
-                col++;
-              }
-            }
-            while (pad-- > 0)
-            {
-              memcpy(wptr, src, pl);
-              wptr += pl;
-              wlen += pl;
-              col += pw;
-            }
-          }
-          else if (soft)
+        pad = (cols - col - wid) / pw;
+        if (pad >= 0)
+        {
+          /* try to consume as many columns as we can, if we don't have
+           * memory for that, use as much memory as possible */
+          if (wlen + (pad * pl) + len > buflen)
+            pad = (buflen > (wlen + len)) ? ((buflen - wlen - len) / pl) : 0;
+          else
           {
-            int offset = ((flags & MUTT_FORMAT_ARROWCURSOR) && C_ArrowCursor) ?
-                             mutt_strwidth(C_ArrowString) + 1 :
-                             0;
-            int avail_cols = (cols > offset) ? (cols - offset) : 0;
-            /* \0-terminate buf for length computation in mutt_wstr_trunc() */
-            *wptr = '\0';
-            /* make sure right part is at most as wide as display */
-            len = mutt_wstr_trunc(tmp, buflen, avail_cols, &wid);
-            /* truncate left so that right part fits completely in */
-            wlen = mutt_wstr_trunc(buf, buflen - len, avail_cols - wid, &col);
-            wptr = buf + wlen;
-            /* Multi-column characters may be truncated in the middle.
-             * Add spacing so the right hand side lines up. */
-            while ((col + wid < avail_cols) && (wlen + len < buflen))
+            /* Add pre-spacing to make multi-column pad characters and
+             * the contents after padding line up */
+            while ((col + (pad * pw) + wid < cols) && (wlen + (pad * pl) + len < buflen))
             {
               *wptr++ = ' ';
               wlen++;
               col++;
             }
           }
-          if ((len + wlen) > buflen)
-            len = mutt_wstr_trunc(tmp, buflen - wlen, cols - col, NULL);
-          memcpy(wptr, tmp, len);
-          wptr += len;
-        }
-        break; /* skip rest of input */
-      }
-      else if (ch == '|')
-      {
-        /* pad to EOL */
-        int pl, pw;
-        pl = mutt_mb_charlen(src, &pw);
-        if (pl <= 0)
-        {
-          pl = 1;
-          pw = 1;
-        }
-
-        /* see if there's room to add content, else ignore */
-        if ((col < cols) && (wlen < buflen))
-        {
-          int c = (cols - col) / pw;
-          if ((c > 0) && (wlen + (c * pl) > buflen))
-            c = ((signed) (buflen - wlen)) / pl;
-          while (c > 0)
+          while (pad-- > 0)
           {
             memcpy(wptr, src, pl);
             wptr += pl;
             wlen += pl;
             col += pw;
-            c--;
           }
         }
-        break; /* skip rest of input */
-      }
-      else
-      {
-        bool to_lower = false;
-        bool no_dots = false;
-
-        while ((ch == '_') || (ch == ':'))
-        {
-          if (ch == '_')
-            to_lower = true;
-          else if (ch == ':')
-            no_dots = true;
-
-          ch = *src++;
-        }
-
-        /* use callback function to handle this case */
-        src = callback(tmp, sizeof(tmp), col, cols, ch, src, prefix, if_str,
-                       else_str, data, flags);
-
-        if (to_lower)
-          mutt_str_strlower(tmp);
-        if (no_dots)
+        else if (soft)
         {
-          char *p = tmp;
-          for (; *p; p++)
-            if (*p == '.')
-              *p = '_';
+          int offset = ((flags & MUTT_FORMAT_ARROWCURSOR) && C_ArrowCursor) ?
+                           mutt_strwidth(C_ArrowString) + 1 :
+                           0;
+          int avail_cols = (cols > offset) ? (cols - offset) : 0;
+          /* \0-terminate buf for length computation in mutt_wstr_trunc() */
+          *wptr = '\0';
+          /* make sure right part is at most as wide as display */
+          len = mutt_wstr_trunc(tmp, buflen, avail_cols, &wid);
+          /* truncate left so that right part fits completely in */
+          wlen = mutt_wstr_trunc(buf, buflen - len, avail_cols - wid, &col);
+          wptr = buf + wlen;
+          /* Multi-column characters may be truncated in the middle.
+           * Add spacing so the right hand side lines up. */
+          while ((col + wid < avail_cols) && (wlen + len < buflen))
+          {
+            *wptr++ = ' ';
+            wlen++;
+            col++;
+          }
         }
-
-        len = mutt_str_strlen(tmp);
         if ((len + wlen) > buflen)
           len = mutt_wstr_trunc(tmp, buflen - wlen, cols - col, NULL);
-
         memcpy(wptr, tmp, len);
         wptr += len;
-        wlen += len;
-        col += mutt_strwidth(tmp);
-      }
-    }
-    else if (*src == '\\')
-    {
-      if (!*++src)
-        break;
-      switch (*src)
-      {
-        case 'f':
-          *wptr = '\f';
-          break;
-        case 'n':
-          *wptr = '\n';
-          break;
-        case 'r':
-          *wptr = '\r';
-          break;
-        case 't':
-          *wptr = '\t';
-          break;
-        case 'v':
-          *wptr = '\v';
-          break;
-        default:
-          *wptr = *src;
-          break;
       }
-      src++;
-      wptr++;
-      wlen++;
-      col++;
     }
     else
     {
-      int bytes, width;
-      /* in case of error, simply copy byte */
-      bytes = mutt_mb_charlen(src, &width);
-      if (bytes < 0)
-      {
-        bytes = 1;
-        width = 1;
-      }
-      if ((bytes > 0) && ((wlen + bytes) < buflen))
-      {
-        memcpy(wptr, src, bytes);
-        wptr += bytes;
-        src += bytes;
-        wlen += bytes;
-        col += width;
-      }
-      else
+      /* pad to EOL */
+      /* see if there's room to add content, else ignore */
+      if ((col < cols) && (wlen < buflen))
       {
-        src += buflen - wlen;
-        wlen = buflen;
+        int c = (cols - col) / pw;
+        if ((c > 0) && (wlen + (c * pl) > buflen))
+          c = ((signed) (buflen - wlen)) / pl;
+        while (c > 0)
+        {
+          memcpy(wptr, src, pl);
+          wptr += pl;
+          wlen += pl;
+          col += pw;
+          c--;
+        }
       }
     }
+    break; /* skip rest of input */
   }
+
+  format_program_release(prog);
   *wptr = '\0';
 }
 
@@ -1189,15 +1189,31 @@ int mx_msg_close(struct Mailbox *m, struct Message **msg)
  */
 void mx_alloc_memory(struct Mailbox *m)
 {
-  size_t s = MAX(sizeof(struct Email *), sizeof(int));
+  mx_alloc_memory_n(m, m->email_max - m->msg_count + 25);
+}
 
-  if ((m->email_max + 25) * s < m->email_max * s)
+/**
+ * mx_alloc_memory_n - Create storage for a number of new emails
+ * @param m     Mailbox
+ * @param count Number of emails that are about to be added
+ *
+ * If the number of emails is known in advance, this avoids growing the arrays
+ * 25 emails at a time.
+ */
+void mx_alloc_memory_n(struct Mailbox *m, int count)
+{
+  if (count > (INT_MAX - m->msg_count))
   {
     mutt_error(_("Out of memory"));
     mutt_exit(1);
   }
 
-  m->email_max += 25;
+  const int old_max = m->email_max;
+  const int new_max = m->msg_count + count;
+  if (new_max <= old_max)
+    return;
+
+  m->email_max = new_max;
   if (m->emails)
   {
     mutt_mem_realloc(&m->emails, sizeof(struct Email *) * m->email_max);
@@ -1208,7 +1224,7 @@ void mx_alloc_memory(struct Mailbox *m)
     m->emails = mutt_mem_calloc(m->email_max, sizeof(struct Email *));
     m->v2r = mutt_mem_calloc(m->email_max, sizeof(int));
   }
-  for (int i = m->email_max - 25; i < m->email_max; i++)
+  for (int i = old_max; i < m->email_max; i++)
   {
     m->emails[i] = NULL;
     m->v2r[i] = -1;
@@ -1723,3 +1739,33 @@ int mx_save_hcache(struct Mailbox *m, struct Email *e)
 
   return m->mx_ops->msg_save_hcache(m, e);
 }
+
+/**
+ * mx_hcache_begin - Start a batch of header cache saves - Wrapper for MxOps::hcache_begin()
+ * @param m Mailbox
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Each successful call must be paired with mx_hcache_commit().
+ */
+int mx_hcache_begin(struct Mailbox *m)
+{
+  if (!m || !m->mx_ops || !m->mx_ops->hcache_begin)
+    return 0;
+
+  return m->mx_ops->hcache_begin(m);
+}
+
+/**
+ * mx_hcache_commit - Finish a batch of header cache saves - Wrapper for MxOps::hcache_commit()
+ * @param m Mailbox
+ * @retval  0 Success
+ * @retval -1 Failure
+ */
+int mx_hcache_commit(struct Mailbox *m)
+{
+  if (!m || !m->mx_ops || !m->mx_ops->hcache_commit)
+    return 0;
+
+  return m->mx_ops->hcache_commit(m);
+}
@@ -220,6 +220,23 @@ struct MxOps
    * @retval -1 Failure
    */
   int (*msg_save_hcache) (struct Mailbox *m, struct Email *e);
+  /**
+   * hcache_begin - Start a batch of header cache saves
+   * @param m Mailbox
+   * @retval  0 Success
+   * @retval -1 Failure
+   *
+   * Until hcache_commit() is called, msg_save_hcache() may keep using one
+   * header cache, rather than opening and closing it for every email.
+   */
+  int (*hcache_begin)    (struct Mailbox *m);
+  /**
+   * hcache_commit - Finish a batch of header cache saves
+   * @param m Mailbox
+   * @retval  0 Success
+   * @retval -1 Failure
+   */
+  int (*hcache_commit)   (struct Mailbox *m);
   /**
    * tags_edit - Prompt and validate new messages tags
    * @param m      Mailbox
@@ -286,6 +303,8 @@ struct Message *mx_msg_open_new    (struct Mailbox *m, struct Email *e, MsgOpenF
 struct Message *mx_msg_open        (struct Mailbox *m, int msgno);
 int             mx_msg_padding_size(struct Mailbox *m);
 int             mx_save_hcache     (struct Mailbox *m, struct Email *e);
+int             mx_hcache_begin    (struct Mailbox *m);
+int             mx_hcache_commit   (struct Mailbox *m);
 int             mx_path_canon      (char *buf, size_t buflen, const char *folder, enum MailboxType *magic);
 int             mx_path_canon2     (struct Mailbox *m, const char *folder);
 int             mx_path_parent     (char *buf, size_t buflen);
@@ -303,6 +322,7 @@ int             mx_ac_remove (struct Mailbox *m);
 
 int                 mx_access           (const char *path, int flags);
 void                mx_alloc_memory     (struct Mailbox *m);
+void                mx_alloc_memory_n   (struct Mailbox *m, int count);
 int                 mx_check_empty      (const char *path);
 void                mx_fastclose_mailbox(struct Mailbox *m);
 const struct MxOps *mx_get_ops          (enum MailboxType magic);
@@ -742,7 +742,7 @@ void nntp_hcache_update(struct NntpMboxData *mdata, header_cache_t *hc)
   anum_t first = 0, last = 0;
 
   /* fetch previous values of first and last */
-  void *hdata = mutt_hcache_fetch_raw(hc, "index", 5);
+  void *hdata = mutt_hcache_fetch_raw(hc, "index", 5, NULL);
   if (hdata)
   {
     mutt_debug(LL_DEBUG2, "mutt_hcache_fetch index: %s\n", (char *) hdata);
@@ -1151,7 +1151,7 @@ struct NntpAccountData *nntp_select_server(struct Mailbox *m, char *server, bool
           continue;
 
         /* fetch previous values of first and last */
-        hdata = mutt_hcache_fetch_raw(hc, "index", 5);
+        hdata = mutt_hcache_fetch_raw(hc, "index", 5, NULL);
         if (hdata)
         {
           anum_t first, last;
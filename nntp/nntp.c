@@ -1186,14 +1186,13 @@ static int parse_overview_line(char *line, void *data)
 
     /* try to replace with header from cache */
     snprintf(buf, sizeof(buf), "%u", anum);
-    void *hdata = mutt_hcache_fetch(fc->hc, buf, strlen(buf));
-    if (hdata)
+    struct Email *e_cached = mutt_hcache_fetch_email(fc->hc, buf, strlen(buf), NULL);
+    if (e_cached)
     {
       mutt_debug(LL_DEBUG2, "mutt_hcache_fetch %s\n", buf);
       email_free(&e);
-      e = mutt_hcache_restore(hdata);
+      e = e_cached;
       m->emails[m->msg_count] = e;
-      mutt_hcache_free(fc->hc, &hdata);
       e->edata = NULL;
       e->read = false;
       e->old = false;
@@ -1285,6 +1284,11 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     return -1;
   fc.hc = hc;
 
+#ifdef USE_HCACHE
+  /* Write the new headers to the cache in one batch */
+  mutt_hcache_begin(fc.hc);
+#endif
+
   /* fetch list of articles */
   if (C_NntpListgroup && mdata->adata->hasLISTGROUP && !mdata->deleted)
   {
@@ -1354,13 +1358,11 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
 
 #ifdef USE_HCACHE
     /* try to fetch header from cache */
-    void *hdata = mutt_hcache_fetch(fc.hc, buf, strlen(buf));
-    if (hdata)
+    e = mutt_hcache_fetch_email(fc.hc, buf, strlen(buf), NULL);
+    if (e)
     {
       mutt_debug(LL_DEBUG2, "mutt_hcache_fetch %s\n", buf);
-      e = mutt_hcache_restore(hdata);
       m->emails[m->msg_count] = e;
-      mutt_hcache_free(fc.hc, &hdata);
       e->edata = NULL;
 
       /* skip header marked as deleted in cache */
@@ -1476,6 +1478,10 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     }
   }
 
+#ifdef USE_HCACHE
+  mutt_hcache_commit(fc.hc);
+#endif
+
   FREE(&fc.messages);
   if (rc != 0)
     return -1;
@@ -1590,7 +1596,6 @@ static int check_mailbox(struct Mailbox *m)
 #ifdef USE_HCACHE
     unsigned char *messages = NULL;
     char buf[16];
-    void *hdata = NULL;
     struct Email *e = NULL;
     anum_t first = mdata->first_message;
 
@@ -1618,14 +1623,12 @@ static int check_mailbox(struct Mailbox *m)
           messages[anum - first] = 1;
 
         snprintf(buf, sizeof(buf), "%u", anum);
-        hdata = mutt_hcache_fetch(hc, buf, strlen(buf));
-        if (hdata)
+        e = mutt_hcache_fetch_email(hc, buf, strlen(buf), NULL);
+        if (e)
         {
           bool deleted;
 
           mutt_debug(LL_DEBUG2, "#1 mutt_hcache_fetch %s\n", buf);
-          e = mutt_hcache_restore(hdata);
-          mutt_hcache_free(hc, &hdata);
           e->edata = NULL;
           deleted = e->deleted;
           flagged = e->flagged;
@@ -1664,16 +1667,14 @@ static int check_mailbox(struct Mailbox *m)
         continue;
 
       snprintf(buf, sizeof(buf), "%u", anum);
-      hdata = mutt_hcache_fetch(hc, buf, strlen(buf));
-      if (hdata)
+      e = mutt_hcache_fetch_email(hc, buf, strlen(buf), NULL);
+      if (e)
       {
         mutt_debug(LL_DEBUG2, "#2 mutt_hcache_fetch %s\n", buf);
         if (m->msg_count >= m->email_max)
           mx_alloc_memory(m);
 
-        e = mutt_hcache_restore(hdata);
         m->emails[m->msg_count] = e;
-        mutt_hcache_free(hc, &hdata);
         e->edata = NULL;
         if (e->deleted)
         {
@@ -2798,6 +2799,7 @@ static int nntp_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
 
   mutt_env_free(&e->env);
   e->env = mutt_rfc822_read_header(msg->fp, e, false, false);
+  FREE(&e->pattern_memo);
 
   if (m->id_hash && e->env->message_id)
     mutt_hash_insert(m->id_hash, e->env->message_id, e);
@@ -2903,6 +2905,8 @@ struct MxOps MxNntpOps = {
   .msg_close        = nntp_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = NULL,
+  .hcache_begin     = NULL,
+  .hcache_commit    = NULL,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = nntp_path_probe,
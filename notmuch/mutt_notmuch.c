@@ -942,12 +942,9 @@ static void append_message(header_cache_t *h, struct Mailbox *m,
   }
 
 #ifdef USE_HCACHE
-  void *from_cache = mutt_hcache_fetch(h, path, mutt_str_strlen(path));
-  if (from_cache)
-  {
-    e = mutt_hcache_restore(from_cache);
-  }
-  else
+  e = mutt_hcache_fetch_email(h, path, mutt_str_strlen(path), NULL);
+  bool from_cache = (e != NULL);
+  if (!from_cache)
 #endif
   {
     if (access(path, F_OK) == 0)
@@ -980,11 +977,7 @@ static void append_message(header_cache_t *h, struct Mailbox *m,
 
 #ifdef USE_HCACHE
 
-  if (from_cache)
-  {
-    mutt_hcache_free(h, &from_cache);
-  }
-  else
+  if (!from_cache)
   {
     mutt_hcache_store(h, newpath ? newpath : path,
                       mutt_str_strlen(newpath ? newpath : path), e, 0);
@@ -2301,7 +2294,10 @@ static int nm_mbox_check(struct Mailbox *m, int *index_hint)
     }
 
     if (update_email_tags(e, msg) == 0)
+    {
       new_flags++;
+      e->limit_checked = false;
+    }
 
     notmuch_message_destroy(msg);
   }
@@ -2607,6 +2603,8 @@ struct MxOps MxNotmuchOps = {
   .msg_close        = nm_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = NULL,
+  .hcache_begin     = NULL,
+  .hcache_commit    = NULL,
   .tags_edit        = nm_tags_edit,
   .tags_commit      = nm_tags_commit,
   .path_probe       = nm_path_probe,
@@ -198,6 +198,7 @@ struct PagerRedrawData
   struct Line *line_info;
   FILE *fp;
   struct stat sb;
+  bool layout_done; ///< Every line of the file has been laid out
 };
 
 /* hack to return to position when returning from index to same message */
@@ -250,6 +251,7 @@ static struct Mapping PagerNewsHelpExtra[] = {
 #define IsEmail(pager) (pager && (pager)->email && !(pager)->body)
 
 #define NUM_SIG_LINES 4
+#define LAYOUT_AHEAD_LINES 10000 ///< Number of lines to lay out, each time a key is awaited
 
 #define CHECK_MODE(test)                                                       \
   if (!(test))                                                                 \
@@ -965,6 +967,86 @@ int mutt_is_quote_line(char *line, regmatch_t *pmatch)
   return is_quote;
 }
 
+/**
+ * body_color_init - Prepare the body colours for matching a line
+ * @param head List of colours
+ * @param buf  Line of text
+ *
+ * Colours whose regex contains some literal text that's missing from the line
+ * can't match, so they're skipped without running the regex.
+ */
+static void body_color_init(struct ColorLineList *head, const char *buf)
+{
+  struct ColorLine *color_line = NULL;
+  struct Buffer *lower = NULL;
+  bool ascii = true;
+
+  STAILQ_FOREACH(color_line, head, entries)
+  {
+    color_line->stop_matching = false;
+    color_line->next_match.rm_so = -1;
+
+    if (!color_line->literal)
+      continue;
+
+    if (!color_line->literal_icase)
+    {
+      color_line->stop_matching = !strstr(buf, color_line->literal);
+      continue;
+    }
+
+    /* Case-folding is only predictable for plain ASCII text */
+    if (!lower && ascii)
+    {
+      ascii = mutt_str_is_ascii(buf, mutt_str_strlen(buf));
+      if (!ascii)
+        continue;
+      lower = mutt_buffer_pool_get();
+      mutt_buffer_strcpy(lower, buf);
+      for (char *p = lower->data; *p; p++)
+        *p = tolower((unsigned char) *p);
+    }
+    if (lower)
+      color_line->stop_matching = !strstr(mutt_b2s(lower), color_line->literal);
+  }
+
+  mutt_buffer_pool_release(&lower);
+}
+
+/**
+ * body_color_match - Find the next match of a body colour
+ * @param color_line Colour to match
+ * @param buf        Line of text
+ * @param offset     Offset into the line to search from
+ * @param pmatch     Match, relative to offset
+ * @retval true The colour matched
+ *
+ * A match found by an earlier search is still the first match after offset,
+ * unless the regex tests the text before the match, e.g. "\<".
+ */
+static bool body_color_match(struct ColorLine *color_line, const char *buf,
+                             int offset, regmatch_t *pmatch)
+{
+  if (color_line->stop_matching)
+    return false;
+
+  if (color_line->look_behind || (color_line->next_match.rm_so < offset))
+  {
+    if (regexec(&color_line->regex, buf + offset, 1, pmatch,
+                ((offset != 0) ? REG_NOTBOL : 0)) != 0)
+    {
+      return false;
+    }
+    color_line->next_match.rm_so = pmatch[0].rm_so + offset;
+    color_line->next_match.rm_eo = pmatch[0].rm_eo + offset;
+    return true;
+  }
+
+  pmatch[0].rm_so = color_line->next_match.rm_so - offset;
+  pmatch[0].rm_eo = color_line->next_match.rm_eo - offset;
+  return true;
+}
+
 /**
  * resolve_types - Determine the style for a line of text
  * @param[in]  buf          Formatted text
@@ -1105,10 +1187,7 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       head = &Colors->hdr_list;
     else
       head = &Colors->body_list;
-    STAILQ_FOREACH(color_line, head, entries)
-    {
-      color_line->stop_matching = false;
-    }
+    body_color_init(head, buf);
     do
     {
       if (!buf[offset])
@@ -1118,9 +1197,7 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       null_rx = false;
       STAILQ_FOREACH(color_line, head, entries)
       {
-        if (!color_line->stop_matching &&
-            (regexec(&color_line->regex, buf + offset, 1, pmatch,
-                     ((offset != 0) ? REG_NOTBOL : 0)) == 0))
+        if (body_color_match(color_line, buf, offset, pmatch))
         {
           if (pmatch[0].rm_eo != pmatch[0].rm_so)
           {
@@ -1470,24 +1547,35 @@ static int format_line(struct Line **line_info, int n, unsigned char *buf,
     if (ch >= cnt)
       break;
 
-    k = mbrtowc(&wc, (char *) buf + ch, cnt - ch, &mbstate);
-    if ((k == (size_t)(-2)) || (k == (size_t)(-1)))
+    /* Printable ASCII, that isn't overstruck, doesn't need decoding */
+    const bool ascii = (buf[ch] >= ' ') && (buf[ch] < 0x7f) &&
+                       ((cnt - ch < 2) || (buf[ch + 1] != '\b')) && mbsinit(&mbstate);
+    if (ascii)
     {
-      if (k == (size_t)(-1))
-        memset(&mbstate, 0, sizeof(mbstate));
-      mutt_debug(LL_DEBUG1, "mbrtowc returned %lu; errno = %d\n", k, errno);
-      if (col + 4 > wrap_cols)
-        break;
-      col += 4;
-      if (pa)
-        mutt_window_printf("\\%03o", buf[ch]);
+      wc = buf[ch];
       k = 1;
-      continue;
     }
-    if (k == 0)
-      k = 1;
+    else
+    {
+      k = mbrtowc(&wc, (char *) buf + ch, cnt - ch, &mbstate);
+      if ((k == (size_t)(-2)) || (k == (size_t)(-1)))
+      {
+        if (k == (size_t)(-1))
+          memset(&mbstate, 0, sizeof(mbstate));
+        mutt_debug(LL_DEBUG1, "mbrtowc returned %lu; errno = %d\n", k, errno);
+        if (col + 4 > wrap_cols)
+          break;
+        col += 4;
+        if (pa)
+          mutt_window_printf("\\%03o", buf[ch]);
+        k = 1;
+        continue;
+      }
+      if (k == 0)
+        k = 1;
+    }
 
-    if (CharsetIsUtf8)
+    if (CharsetIsUtf8 && !ascii)
     {
       /* zero width space, zero width no-break space */
       if ((wc == 0x200B) || (wc == 0xFEFF))
@@ -1504,7 +1592,7 @@ static int format_line(struct Line **line_info, int n, unsigned char *buf,
 
     /* Handle backspace */
     special = 0;
-    if (IsWPrint(wc))
+    if (!ascii && IsWPrint(wc))
     {
       wchar_t wc1;
       mbstate_t mbstate1 = mbstate;
@@ -1546,13 +1634,13 @@ static int format_line(struct Line **line_info, int n, unsigned char *buf,
     }
 
     /* no-break space, narrow no-break space */
-    if (IsWPrint(wc) || (CharsetIsUtf8 && ((wc == 0x00A0) || (wc == 0x202F))))
+    if (ascii || IsWPrint(wc) || (CharsetIsUtf8 && ((wc == 0x00A0) || (wc == 0x202F))))
     {
       if (wc == ' ')
       {
         space = ch;
       }
-      t = wcwidth(wc);
+      t = ascii ? 1 : wcwidth(wc);
       if (col + t > wrap_cols)
         break;
       col += t;
@@ -1926,6 +2014,42 @@ void mutt_clear_pager_position(void)
   OldEmail = NULL;
 }
 
+/**
+ * pager_layout_ahead - Lay out the lines of the pager while waiting for a key
+ * @param rd Pager data
+ *
+ * The lines are classified and wrapped, a few hundred at a time, until a key
+ * is pressed.  Then, jumping to the bottom, or searching, only has to deal
+ * with the lines that haven't been reached yet.
+ *
+ * At most #LAYOUT_AHEAD_LINES lines are laid out each time, so an idle pager
+ * doesn't fill the Line array of a huge message.  The layout carries on after
+ * the next key.
+ */
+static void pager_layout_ahead(struct PagerRedrawData *rd)
+{
+  if (rd->layout_done || !rd->line_info)
+    return;
+
+  int line_num = MAX(rd->last_line - 1, 0);
+  const int limit = line_num + LAYOUT_AHEAD_LINES;
+  while ((line_num < limit) && !mutt_input_pending())
+  {
+    for (int i = 0; (i < 500) && (line_num < limit); i++, line_num++)
+    {
+      if (display_line(rd->fp, &rd->last_pos, &rd->line_info, line_num,
+                       &rd->last_line, &rd->max_line,
+                       rd->has_types | rd->search_flag | (rd->flags & MUTT_PAGER_NOWRAP),
+                       &rd->quote_list, &rd->q_level, &rd->force_redraw,
+                       &rd->search_re, rd->extra->win_pager) != 0)
+      {
+        rd->layout_done = true;
+        return;
+      }
+    }
+  }
+}
+
 /**
  * pager_custom_redraw - Redraw the pager window - Implements Menu::custom_redraw()
  */
@@ -2048,6 +2172,7 @@ static void pager_custom_redraw(struct Menu *pager_menu)
       rd->last_line = 0;
       rd->topline = 0;
     }
+    rd->layout_done = false;
     int i = -1;
     int j = -1;
     while (display_line(rd->fp, &rd->last_pos, &rd->line_info, ++i, &rd->last_line,
@@ -2314,6 +2439,8 @@ int mutt_pager(const char *banner, const char *fname, PagerFlags flags, struct P
   {
     mutt_curses_set_cursor(MUTT_CURSOR_INVISIBLE);
 
+    /* the last function may have changed the Emails in the index */
+    index_invalidate_lines();
     pager_custom_redraw(pager_menu);
 
     if (C_BrailleFriendly)
@@ -2341,6 +2468,8 @@ int mutt_pager(const char *banner, const char *fname, PagerFlags flags, struct P
     else
       OldEmail = NULL;
 
+    pager_layout_ahead(&rd);
+
     ch = km_dokey(MENU_PAGER);
     if (ch >= 0)
     {
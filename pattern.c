@@ -199,6 +199,34 @@ static struct RangeRegex range_regexes[] = {
 static struct PatternList *SearchPattern = NULL; ///< current search pattern
 static char LastSearch[256] = { 0 };             ///< last pattern searched for
 static char LastSearchExpn[1024] = { 0 }; ///< expanded version of LastSearch
+#ifndef USE_FMEMOPEN
+static FILE *SearchFile = NULL; ///< Reusable temporary file for thorough searches
+#endif
+static unsigned int PatternMemoGen = 1; ///< Remembered results from other generations are stale
+
+/**
+ * struct PatternResult - The result of matching a Pattern against an Email
+ */
+struct PatternResult
+{
+  const struct Pattern *pat; ///< Pattern that was matched
+  PatternExecFlags flags;    ///< Flags it was matched with
+  bool match;                ///< Did it match?
+};
+
+/**
+ * struct PatternMemo - Remembered results of matching Patterns against an Email
+ *
+ * Only Patterns whose result depends on nothing but the Email's headers and
+ * body are remembered; flags, tags, dates, etc are cheap to test again.
+ */
+struct PatternMemo
+{
+  unsigned int gen;               ///< #PatternMemoGen when the results were saved
+  int num;                        ///< Number of results
+  int max;                        ///< Space for results
+  struct PatternResult results[]; ///< Results
+};
 
 /**
  * typedef addr_predicate_t - Test an Address for some condition
@@ -207,6 +235,23 @@ static char LastSearchExpn[1024] = { 0 }; ///< expanded version of LastSearch
  */
 typedef bool (*addr_predicate_t)(const struct Address *a);
 
+/**
+ * regex_is_plain - Is a regex just plain text?
+ * @param regex Extended regular expression
+ * @retval true The regex only matches itself
+ *
+ * Only printable ASCII is accepted, so that ignoring the case is simple.
+ */
+static bool regex_is_plain(const char *regex)
+{
+  for (const unsigned char *p = (const unsigned char *) regex; *p; p++)
+  {
+    if ((*p < ' ') || (*p >= 0x7f) || strchr("^.[$()|*+?{\\", *p))
+      return false;
+  }
+  return true;
+}
+
 /**
  * eat_regex - Parse a regex - Implements Pattern::eat_arg()
  */
@@ -233,6 +278,8 @@ static bool eat_regex(struct Pattern *pat, int flags, struct Buffer *s, struct B
   {
     pat->p.str = mutt_str_strdup(buf.data);
     pat->ign_case = mutt_mb_is_lower(buf.data);
+    if (mutt_str_strlen(buf.data) >= 3)
+      pat->literal = mutt_str_strdup(buf.data);
     FREE(&buf.data);
   }
   else if (pat->group_match)
@@ -254,6 +301,16 @@ static bool eat_regex(struct Pattern *pat, int flags, struct Buffer *s, struct B
       FREE(&pat->p.regex);
       return false;
     }
+    if (regex_is_plain(buf.data))
+    {
+      pat->literal = mutt_str_strdup(buf.data);
+      pat->is_literal = true;
+      pat->ign_case = (case_flags != 0);
+    }
+    else
+    {
+      pat->literal = mutt_regex_literal(buf.data, false);
+    }
     FREE(&buf.data);
   }
 
@@ -1106,6 +1163,70 @@ out:
   return rc;
 }
 
+/**
+ * literal_find - Look for a plain string in some text
+ * @param text     Text to search
+ * @param str      String to look for, in lower case if ign_case is set
+ * @param ign_case Ignore the case of ASCII letters
+ * @retval true The text contains the string
+ *
+ * The scan for where a match could start is left to strchr() and strstr(),
+ * which the C library vectorises.  Ignoring case, the text is scanned for
+ * both cases of the first letter, keeping the nearest of each.
+ */
+static bool literal_find(const char *text, const char *str, bool ign_case)
+{
+  if (!ign_case)
+    return strstr(text, str);
+
+  const char lc = str[0];
+  const char uc = ((lc >= 'a') && (lc <= 'z')) ? (lc - ('a' - 'A')) : lc;
+  const char *lp = strchr(text, lc);
+  const char *up = (uc != lc) ? strchr(text, uc) : NULL;
+
+  while (lp || up)
+  {
+    const char *p = NULL;
+    if (lp && (!up || (lp < up)))
+    {
+      p = lp;
+      lp = strchr(lp + 1, lc);
+    }
+    else
+    {
+      p = up;
+      up = strchr(up + 1, uc);
+    }
+
+    size_t i = 1;
+    for (; str[i]; i++)
+    {
+      char c = p[i];
+      if ((c >= 'A') && (c <= 'Z'))
+        c += 'a' - 'A';
+      if (c != str[i])
+        break;
+    }
+    if (str[i] == '\0')
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * has_8bit - Does some text contain any non-ASCII characters?
+ * @param text Text to check
+ * @retval true It does
+ */
+static bool has_8bit(const char *text)
+{
+  for (const unsigned char *p = (const unsigned char *) text; *p; p++)
+    if (*p >= 0x80)
+      return true;
+  return false;
+}
+
 /**
  * patmatch - Compare a string to a Pattern
  * @param pat Pattern to use
@@ -1121,9 +1242,129 @@ static bool patmatch(const struct Pattern *pat, const char *buf)
     return pat->ign_case ? strcasestr(buf, pat->p.str) : strstr(buf, pat->p.str);
   if (pat->group_match)
     return mutt_group_match(pat->p.group, buf);
+  if (pat->is_literal)
+  {
+    if (literal_find(buf, pat->literal, pat->ign_case))
+      return true;
+    /* Case folding beyond ASCII is left to the regex, e.g. the Kelvin sign */
+    if (!pat->ign_case || !has_8bit(buf))
+      return false;
+  }
   return (regexec(pat->p.regex, buf, 0, NULL, 0) == 0);
 }
 
+#ifndef USE_FMEMOPEN
+/**
+ * search_file_get - Get an empty temporary file for a thorough search
+ * @retval ptr  Temporary file
+ * @retval NULL Error
+ *
+ * The file is kept and reused, to save creating and deleting a file for every
+ * message searched.
+ */
+static FILE *search_file_get(void)
+{
+  if (SearchFile &&
+      ((fseeko(SearchFile, 0, SEEK_SET) != 0) || (ftruncate(fileno(SearchFile), 0) != 0)))
+  {
+    mutt_file_fclose(&SearchFile);
+  }
+
+  if (!SearchFile)
+    SearchFile = mutt_file_mkstemp();
+
+  return SearchFile;
+}
+#endif
+
+/**
+ * search_copy_verbatim - Copy a plain text body as the handler would
+ * @param m      Mailbox
+ * @param e      Email, whose body is plain text, see mutt_body_is_verbatim()
+ * @param fp_in  File to read the body from
+ * @param fp_out File to write the text to
+ * @retval true  Success
+ * @retval false The text isn't ASCII, so it must be decoded
+ *
+ * This gives the same text as mutt_body_handler(), but without the cost of
+ * decoding the body into a temporary file and converting its character set.
+ *
+ * While the text is at hand, it's summarised in a BodyFilter, which is saved in
+ * the header cache so that later searches can skip the email.
+ */
+static bool search_copy_verbatim(struct Mailbox *m, struct Email *e, FILE *fp_in, FILE *fp_out)
+{
+  struct Body *b = e->content;
+  struct Buffer *buf = mutt_buffer_pool_get();
+  mutt_buffer_alloc(buf, b->length + 2);
+
+  bool rc = true;
+  size_t bol = 0;
+  LOFF_T len = b->length;
+  int c;
+
+  fseeko(fp_in, b->offset, SEEK_SET);
+  while ((len > 0) && ((c = fgetc(fp_in)) != EOF))
+  {
+    len--;
+    if ((c == '\0') || (c & 0x80))
+    {
+      rc = false;
+      break;
+    }
+
+    if (c == '\n')
+    {
+      /* The decoder and then the text handler each drop a CR before the LF */
+      for (int i = 0; (i < 2) && (mutt_buffer_len(buf) > bol) && (buf->dptr[-1] == '\r'); i++)
+        *--buf->dptr = '\0';
+      mutt_buffer_addch(buf, '\n');
+      bol = mutt_buffer_len(buf);
+      continue;
+    }
+
+    mutt_buffer_addch(buf, c);
+  }
+
+  if (rc)
+  {
+    /* The text handler ends every line with a LF */
+    if (mutt_buffer_len(buf) > bol)
+      mutt_buffer_addch(buf, '\n');
+    fwrite(buf->data, 1, mutt_buffer_len(buf), fp_out);
+
+    if (!e->body_filter)
+    {
+      e->body_filter = body_filter_new(buf->data, mutt_buffer_len(buf));
+      mx_save_hcache(m, e);
+    }
+  }
+
+  mutt_buffer_pool_release(&buf);
+  return rc;
+}
+
+/**
+ * body_filter_excludes - Does the BodyFilter show that a body can't match?
+ * @param pat Pattern to find, searching the body
+ * @param e   Email
+ * @retval true The body doesn't contain the text the Pattern needs
+ *
+ * The filter summarises the raw text of the body.  It can only be used if
+ * that's what will be searched, i.e. if the body doesn't need decoding.
+ */
+static bool body_filter_excludes(struct Pattern *pat, struct Email *e)
+{
+  if (!e->body_filter || !pat->literal)
+    return false;
+
+  if (C_ThoroughSearch && ((e->security & SEC_ENCRYPT) || !mutt_body_is_verbatim(e->content)))
+    return false;
+
+  return !body_filter_may_contain(e->body_filter, pat->literal,
+                                  mutt_str_strlen(pat->literal));
+}
+
 /**
  * msg_search - Search an email
  * @param m   Mailbox
@@ -1135,6 +1376,13 @@ static bool patmatch(const struct Pattern *pat, const char *buf)
 static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 {
   bool match = false;
+  struct Email *e = m->emails[msgno];
+
+  /* If the body can't match, it needn't be read */
+  bool skip_body = (pat->op != MUTT_PAT_HEADER) && body_filter_excludes(pat, e);
+  if (skip_body && (pat->op == MUTT_PAT_BODY))
+    return match;
+
   struct Message *msg = mx_msg_open(m, msgno);
   if (!msg)
   {
@@ -1143,7 +1391,6 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 
   FILE *fp = NULL;
   long lng = 0;
-  struct Email *e = m->emails[msgno];
 #ifdef USE_FMEMOPEN
   char *temp = NULL;
   size_t tempsize;
@@ -1165,7 +1412,7 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
       return false;
     }
 #else
-    s.fp_out = mutt_file_mkstemp();
+    s.fp_out = search_file_get();
     if (!s.fp_out)
     {
       mutt_perror(_("Can't create temporary file"));
@@ -1176,7 +1423,10 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
     if (pat->op != MUTT_PAT_BODY)
       mutt_copy_header(msg->fp, e, s.fp_out, CH_FROM | CH_DECODE, NULL, 0);
 
-    if (pat->op != MUTT_PAT_HEADER)
+    /* Plain text only needs copying, anything else is decoded */
+    if ((pat->op != MUTT_PAT_HEADER) && !skip_body &&
+        ((e->security & SEC_ENCRYPT) || !mutt_body_is_verbatim(e->content) ||
+         !search_copy_verbatim(m, e, msg->fp, s.fp_out)))
     {
       mutt_parse_mime_message(m, e);
 
@@ -1184,13 +1434,10 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
           !crypt_valid_passphrase(e->security))
       {
         mx_msg_close(m, &msg);
-        if (s.fp_out)
-        {
-          mutt_file_fclose(&s.fp_out);
 #ifdef USE_FMEMOPEN
-          FREE(&temp);
+        mutt_file_fclose(&s.fp_out);
+        FREE(&temp);
 #endif
-        }
         return false;
       }
 
@@ -1237,7 +1484,7 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
       fseeko(fp, e->offset, SEEK_SET);
       lng = e->content->offset - e->offset;
     }
-    if (pat->op != MUTT_PAT_HEADER)
+    if ((pat->op != MUTT_PAT_HEADER) && !skip_body)
     {
       if (pat->op == MUTT_PAT_BODY)
         fseeko(fp, e->content->offset, SEEK_SET);
@@ -1271,14 +1518,14 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 
   mx_msg_close(m, &msg);
 
+#ifdef USE_FMEMOPEN
   if (C_ThoroughSearch)
   {
     mutt_file_fclose(&fp);
-#ifdef USE_FMEMOPEN
     if (tempsize)
       FREE(&temp);
-#endif
   }
+#endif
 
   return match;
 }
@@ -1406,7 +1653,10 @@ void mutt_pattern_free(struct PatternList **pat)
       FREE(&np->p.regex);
     }
 
+    FREE(&np->literal);
     mutt_pattern_free(&np->child);
+    /* A new Pattern may be allocated at the same address */
+    PatternMemoGen++;
     FREE(&np);
 
     np = next;
@@ -1428,6 +1678,115 @@ static struct PatternList *mutt_pattern_node_new(void)
   return h;
 }
 
+/**
+ * pattern_cost - Estimate the cost of evaluating a simple Pattern
+ * @param pat Pattern, not a logical or thread operator
+ * @retval num Relative cost
+ */
+static int pattern_cost(const struct Pattern *pat)
+{
+  switch (pat->op)
+  {
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+      return 100; /* read the message */
+    case MUTT_PAT_MIMEATTACH:
+    case MUTT_PAT_MIMETYPE:
+      return 50; /* parse the message's MIME structure */
+    case MUTT_PAT_TO:
+    case MUTT_PAT_CC:
+    case MUTT_PAT_FROM:
+    case MUTT_PAT_SENDER:
+    case MUTT_PAT_RECIPIENT:
+    case MUTT_PAT_ADDRESS:
+    case MUTT_PAT_LIST:
+    case MUTT_PAT_SUBSCRIBED_LIST:
+    case MUTT_PAT_PERSONAL_RECIP:
+    case MUTT_PAT_PERSONAL_FROM:
+      return 4; /* check every address */
+    case MUTT_PAT_SUBJECT:
+    case MUTT_PAT_ID:
+    case MUTT_PAT_ID_EXTERNAL:
+    case MUTT_PAT_HORMEL:
+    case MUTT_PAT_REFERENCE:
+    case MUTT_PAT_XLABEL:
+    case MUTT_PAT_DRIVER_TAGS:
+#ifdef USE_NNTP
+    case MUTT_PAT_NEWSGROUPS:
+#endif
+      return 2; /* match a header */
+    default:
+      return 1; /* test a flag or a number */
+  }
+}
+
+/**
+ * pattern_reorder - Put the cheapest Patterns first
+ * @param pl List of Patterns
+ * @retval num Estimated cost of evaluating the whole list
+ *
+ * The members of a list are ANDed or ORed, so their order doesn't change the
+ * result.  Evaluating the cheap ones first means that the expensive ones, e.g.
+ * body searches, can often be skipped.  Sub-patterns are reordered too.
+ */
+static int pattern_reorder(struct PatternList *pl)
+{
+  struct PatternCost
+  {
+    struct Pattern *pat;
+    int cost;
+  };
+
+  struct Pattern *np = NULL;
+  int count = 0;
+  SLIST_FOREACH(np, pl, entries)
+  {
+    count++;
+  }
+
+  struct PatternCost *pc = mutt_mem_calloc(count, sizeof(*pc));
+  int total = 0;
+  int i = 0;
+
+  while ((np = SLIST_FIRST(pl)))
+  {
+    SLIST_REMOVE_HEAD(pl, entries);
+
+    int cost;
+    switch (np->op)
+    {
+      case MUTT_PAT_AND:
+      case MUTT_PAT_OR:
+        cost = pattern_reorder(np->child);
+        break;
+      case MUTT_PAT_THREAD:
+      case MUTT_PAT_PARENT:
+      case MUTT_PAT_CHILDREN:
+        /* evaluated for several emails */
+        cost = 10 * pattern_reorder(np->child);
+        break;
+      default:
+        cost = pattern_cost(np);
+        break;
+    }
+    total += cost;
+
+    /* insertion sort, keeping equal costs in the user's order */
+    int j = i++;
+    for (; (j > 0) && (pc[j - 1].cost > cost); j--)
+      pc[j] = pc[j - 1];
+    pc[j].pat = np;
+    pc[j].cost = cost;
+  }
+
+  for (i = count - 1; i >= 0; i--)
+    SLIST_INSERT_HEAD(pl, pc[i].pat, entries);
+
+  FREE(&pc);
+  return total;
+}
+
 /**
  * mutt_pattern_comp - Create a Pattern
  * @param s     Pattern string
@@ -1679,6 +2038,7 @@ struct PatternList *mutt_pattern_comp(const char *s, PatternCompFlags flags, str
     curlist = tmp;
   }
 
+  pattern_reorder(curlist);
   return curlist;
 
 cleanup:
@@ -2107,23 +2467,152 @@ static int msg_search_sendmode(struct Email *e, struct Pattern *pat)
 }
 
 /**
- * mutt_pattern_exec - Match a pattern against an email header
+ * pattern_memo_allowed - Can the result of a Pattern be remembered?
+ * @param pat Pattern
+ * @param m   Mailbox
+ * @param e   Email
+ * @retval true The result only depends on the Email's headers and body
+ */
+static bool pattern_memo_allowed(const struct Pattern *pat, struct Mailbox *m,
+                                 struct Email *e)
+{
+  /* Aliases and groups can change, as can the time */
+  if (pat->is_alias || pat->group_match || pat->dynamic)
+    return false;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+      /* A passphrase may be entered later */
+      if (pat->sendmode || !m || (e->security & SEC_ENCRYPT))
+        return false;
+#ifdef USE_IMAP
+      /* The result comes from the last server-side search */
+      if ((m->magic == MUTT_IMAP) && pat->string_match)
+        return false;
+#endif
+      return true;
+    case MUTT_PAT_TO:
+    case MUTT_PAT_CC:
+    case MUTT_PAT_FROM:
+    case MUTT_PAT_SENDER:
+    case MUTT_PAT_RECIPIENT:
+    case MUTT_PAT_ADDRESS:
+    case MUTT_PAT_SUBJECT:
+    case MUTT_PAT_ID:
+    case MUTT_PAT_ID_EXTERNAL:
+    case MUTT_PAT_HORMEL:
+    case MUTT_PAT_REFERENCE:
+    case MUTT_PAT_MIMETYPE:
+#ifdef USE_NNTP
+    case MUTT_PAT_NEWSGROUPS:
+#endif
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * pattern_memo_find - Find the remembered result of a Pattern
+ * @param e     Email
+ * @param pat   Pattern
+ * @param flags Flags the Pattern is matched with
+ * @retval ptr  Result
+ * @retval NULL The result isn't known
+ */
+static struct PatternResult *pattern_memo_find(struct Email *e, const struct Pattern *pat,
+                                               PatternExecFlags flags)
+{
+  struct PatternMemo *pm = e->pattern_memo;
+  if (!pm || (pm->gen != PatternMemoGen))
+    return NULL;
+
+  for (int i = 0; i < pm->num; i++)
+  {
+    if ((pm->results[i].pat == pat) && (pm->results[i].flags == flags))
+      return &pm->results[i];
+  }
+
+  return NULL;
+}
+
+/**
+ * pattern_memo_add - Remember the result of a Pattern
+ * @param e     Email
+ * @param pat   Pattern
+ * @param flags Flags the Pattern was matched with
+ * @param match Did it match?
+ */
+static void pattern_memo_add(struct Email *e, const struct Pattern *pat,
+                             PatternExecFlags flags, bool match)
+{
+  struct PatternMemo *pm = e->pattern_memo;
+  if (!pm)
+  {
+    pm = mutt_mem_calloc(1, sizeof(struct PatternMemo) + (4 * sizeof(struct PatternResult)));
+    pm->gen = PatternMemoGen;
+    pm->max = 4;
+    e->pattern_memo = pm;
+  }
+  else if (pm->gen != PatternMemoGen)
+  {
+    pm->gen = PatternMemoGen;
+    pm->num = 0;
+  }
+
+  if (pm->num == pm->max)
+  {
+    pm->max *= 2;
+    mutt_mem_realloc(&e->pattern_memo,
+                     sizeof(struct PatternMemo) + (pm->max * sizeof(struct PatternResult)));
+    pm = e->pattern_memo;
+  }
+
+  pm->results[pm->num].pat = pat;
+  pm->results[pm->num].flags = flags;
+  pm->results[pm->num].match = match;
+  pm->num++;
+}
+
+/**
+ * mutt_pattern_memo_observer - Forget all Pattern results when the config changes - Implements ::observer_t
+ *
+ * Settings such as $thorough_search affect the results.
+ */
+int mutt_pattern_memo_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type == NT_CONFIG)
+    PatternMemoGen++;
+  return 0;
+}
+
+/**
+ * pattern_exec - Match a pattern against an email header
  * @param pat   Pattern to match
  * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
- * @param m   Mailbox
+ * @param m     Mailbox
  * @param e     Email
  * @param cache Cache for common Patterns
  * @retval  1 Success, pattern matched
  * @retval  0 Pattern did not match
  * @retval -1 Error
- *
- * flags: MUTT_MATCH_FULL_ADDRESS - match both personal and machine address
- * cache: For repeated matches against the same Header, passing in non-NULL will
- *        store some of the cacheable pattern matches in this structure.
  */
-int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
-                      struct Mailbox *m, struct Email *e, struct PatternCache *cache)
+static int pattern_exec(struct Pattern *pat, PatternExecFlags flags,
+                        struct Mailbox *m, struct Email *e, struct PatternCache *cache)
 {
+#ifdef USE_IMAP
+  /* imap_search() had the server evaluate this part of the pattern */
+  if (pat->server_search && m && (m->magic == MUTT_IMAP))
+  {
+    int rc = imap_search_matched(m, pat, e);
+    if (rc >= 0)
+      return rc;
+  }
+#endif
+
   switch (pat->op)
   {
     case MUTT_PAT_AND:
@@ -2184,7 +2673,7 @@ int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       if (!m)
         return 0;
 #ifdef USE_IMAP
-      /* IMAP search sets e->matched at search compile time */
+      /* Only the server can do an IMAP string search, see imap_search() */
       if ((m->magic == MUTT_IMAP) && pat->string_match)
         return e->matched;
 #endif
@@ -2399,6 +2888,40 @@ int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
   return -1;
 }
 
+
+/**
+ * mutt_pattern_exec - Match a pattern against an email header
+ * @param pat   Pattern to match
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m   Mailbox
+ * @param e     Email
+ * @param cache Cache for common Patterns
+ * @retval  1 Success, pattern matched
+ * @retval  0 Pattern did not match
+ * @retval -1 Error
+ *
+ * flags: MUTT_MATCH_FULL_ADDRESS - match both personal and machine address
+ * cache: For repeated matches against the same Header, passing in non-NULL will
+ *        store some of the cacheable pattern matches in this structure.
+ *        The results of expensive Patterns, e.g. regexes and body searches, are
+ *        also remembered in the Email, until the Patterns or config change.
+ */
+int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
+                      struct Mailbox *m, struct Email *e, struct PatternCache *cache)
+{
+  if (!cache || !e || !pattern_memo_allowed(pat, m, e))
+    return pattern_exec(pat, flags, m, e, cache);
+
+  struct PatternResult *pr = pattern_memo_find(e, pat, flags);
+  if (pr)
+    return pr->match;
+
+  int rc = pattern_exec(pat, flags, m, e, cache);
+  if (rc >= 0)
+    pattern_memo_add(e, pat, flags, rc);
+
+  return rc;
+}
 /**
  * quote_simple - Apply simple quoting to a string
  * @param str    String to quote
@@ -2523,6 +3046,7 @@ bool mutt_limit_current_thread(struct Email *e)
 
     e->vnum = -1;
     e->limited = false;
+    e->limit_checked = true;
     e->collapsed = false;
     e->num_hidden = 0;
 
@@ -2592,6 +3116,9 @@ int mutt_pattern_func(int op, char *prompt)
   mutt_progress_init(&progress, _("Executing command on matching messages..."),
                      MUTT_PROGRESS_READ, (op == MUTT_LIMIT) ? m->msg_count : m->vcount);
 
+  /* Bodies searched for the first time are summarised in the header cache */
+  const bool hc_batch = (mx_hcache_begin(m) == 0);
+
   if (op == MUTT_LIMIT)
   {
     m->vcount = 0;
@@ -2609,6 +3136,7 @@ int mutt_pattern_func(int op, char *prompt)
       /* new limit pattern implicitly uncollapses all threads */
       e->vnum = -1;
       e->limited = false;
+      e->limit_checked = true;
       e->collapsed = false;
       e->num_hidden = 0;
       if (mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
@@ -2649,6 +3177,9 @@ int mutt_pattern_func(int op, char *prompt)
     }
   }
 
+  if (hc_batch)
+    mx_hcache_commit(m);
+
   mutt_clear_error();
 
   if (op == MUTT_LIMIT)
@@ -2668,7 +3199,9 @@ int mutt_pattern_func(int op, char *prompt)
     {
       Context->pattern = simple;
       simple = NULL; /* don't clobber it */
-      Context->limit_pattern = mutt_pattern_comp(buf->data, MUTT_PC_FULL_MSG, &err);
+      /* keep the compiled pattern, to check new mail against */
+      Context->limit_pattern = pat;
+      pat = NULL;
     }
   }
 
@@ -2765,6 +3298,10 @@ int mutt_search_command(int cur, int op)
   mutt_progress_init(&progress, _("Searching..."), MUTT_PROGRESS_READ,
                      Context->mailbox->vcount);
 
+  /* Bodies searched for the first time are summarised in the header cache */
+  int rc = -1;
+  const bool hc_batch = (mx_hcache_begin(Context->mailbox) == 0);
+
   for (int i = cur + incr, j = 0; j != Context->mailbox->vcount; j++)
   {
     const char *msg = NULL;
@@ -2777,7 +3314,7 @@ int mutt_search_command(int cur, int op)
       else
       {
         mutt_message(_("Search hit bottom without finding match"));
-        return -1;
+        goto done;
       }
     }
     else if (i < 0)
@@ -2788,7 +3325,7 @@ int mutt_search_command(int cur, int op)
       else
       {
         mutt_message(_("Search hit top without finding match"));
-        return -1;
+        goto done;
       }
     }
 
@@ -2801,7 +3338,8 @@ int mutt_search_command(int cur, int op)
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
-        return i;
+        rc = i;
+        goto done;
       }
     }
     else
@@ -2815,7 +3353,8 @@ int mutt_search_command(int cur, int op)
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
-        return i;
+        rc = i;
+        goto done;
       }
     }
 
@@ -2823,12 +3362,16 @@ int mutt_search_command(int cur, int op)
     {
       mutt_error(_("Search interrupted"));
       SigInt = 0;
-      return -1;
+      goto done;
     }
 
     i += incr;
   }
 
   mutt_error(_("Not found"));
-  return -1;
+
+done:
+  if (hc_batch)
+    mx_hcache_commit(Context->mailbox);
+  return rc;
 }
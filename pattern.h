@@ -34,6 +34,7 @@
 struct Email;
 struct Envelope;
 struct Mailbox;
+struct NotifyCallback;
 
 /* These Config Variables are only used in pattern.c */
 extern bool C_ThoroughSearch;
@@ -54,13 +55,16 @@ struct Pattern
   bool all_addr     : 1;         ///< All Addresses in the list must match
   bool string_match : 1;         ///< Check a string for a match
   bool group_match  : 1;         ///< Check a group of Addresses
-  bool ign_case     : 1;         ///< Ignore case for local string_match searches
+  bool ign_case     : 1;         ///< Ignore case for local string_match and is_literal searches
   bool is_alias     : 1;         ///< Is there an alias for this Address?
   bool dynamic      : 1;         ///< Evaluate date ranges at run time
   bool sendmode     : 1;         ///< Evaluate searches in send-mode
   bool is_multi     : 1;         ///< Multiple case (only for ~I pattern now)
+  bool server_search : 1;        ///< Evaluated by the server, see imap_search()
+  bool is_literal   : 1;         ///< Regex is plain text, so match the literal instead
   int min;                       ///< Minimum for range checks
   int max;                       ///< Maximum for range checks
+  char *literal;                 ///< Text that every match contains, if known
   struct PatternList *child;     ///< Arguments to logical operation
   union {
     regex_t *regex;              ///< Compiled regex, for non-pattern matching
@@ -81,7 +85,8 @@ typedef uint8_t PatternExecFlags;         ///< Flags for mutt_pattern_exec(), e.
  *
  * This is used when a message is repeatedly pattern matched against.
  * e.g. for color, scoring, hooks.  It caches a few of the potentially slow
- * operations.
+ * operations.  Passing one also lets mutt_pattern_exec() remember the results
+ * of regex and body matches in the Email, for the next time.
  * Each entry has a value of 0 = unset, 1 = false, 2 = true
  */
 struct PatternCache
@@ -162,6 +167,7 @@ int mutt_which_case(const char *s);
 int mutt_is_list_recipient(bool all_addr, struct Envelope *e);
 int mutt_is_subscribed_list_recipient(bool all_addr, struct Envelope *e);
 int mutt_pattern_func(int op, char *prompt);
+int mutt_pattern_memo_observer(struct NotifyCallback *nc);
 int mutt_search_command(int cur, int op);
 
 bool mutt_limit_current_thread(struct Email *e);
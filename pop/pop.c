@@ -449,14 +449,18 @@ static int pop_fetch_headers(struct Mailbox *m)
     }
 
     bool hcached = false;
+#ifdef USE_HCACHE
+    /* Write the new headers to the cache in one batch */
+    mutt_hcache_begin(hc);
+#endif
     for (i = old_count; i < new_count; i++)
     {
       if (!m->quiet)
         mutt_progress_update(&progress, i + 1 - old_count, -1);
       struct PopEmailData *edata = pop_edata_get(m->emails[i]);
 #ifdef USE_HCACHE
-      void *data = mutt_hcache_fetch(hc, edata->uid, strlen(edata->uid));
-      if (data)
+      struct Email *e = mutt_hcache_fetch_email(hc, edata->uid, strlen(edata->uid), NULL);
+      if (e)
       {
         /* Detach the private data */
         m->emails[i]->edata = NULL;
@@ -469,8 +473,6 @@ static int pop_fetch_headers(struct Mailbox *m)
          *   data freed separately elsewhere
          *   (the old e->data should point inside a malloc'd block from
          *   hcache so there shouldn't be a memleak here) */
-        struct Email *e = mutt_hcache_restore((unsigned char *) data);
-        mutt_hcache_free(hc, &data);
         email_free(&m->emails[i]);
         m->emails[i] = e;
         m->emails[i]->index = index;
@@ -521,6 +523,9 @@ static int pop_fetch_headers(struct Mailbox *m)
 
       m->msg_count++;
     }
+#ifdef USE_HCACHE
+    mutt_hcache_commit(hc);
+#endif
   }
 
 #ifdef USE_HCACHE
@@ -1168,6 +1173,7 @@ static int pop_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
   mutt_label_hash_remove(m, e);
   mutt_env_free(&e->env);
   e->env = mutt_rfc822_read_header(msg->fp, e, false, false);
+  FREE(&e->pattern_memo);
   if (m->subj_hash && e->env->real_subj)
     mutt_hash_insert(m->subj_hash, e->env->real_subj, e);
   mutt_label_hash_add(m, e);
@@ -1295,6 +1301,8 @@ struct MxOps MxPopOps = {
   .msg_close        = pop_msg_close,
   .msg_padding_size = NULL,
   .msg_save_hcache  = pop_msg_save_hcache,
+  .hcache_begin     = NULL,
+  .hcache_commit    = NULL,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
   .path_probe       = pop_path_probe,
@@ -28,6 +28,7 @@
  */
 
 #include "config.h"
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -356,6 +357,271 @@ sort_t mutt_get_sort_func(enum SortType method)
   /* not reached */
 }
 
+#define SORT_KEY_CODE(method, x) (((method) & SORT_REVERSE) ? -(x) : (x))
+
+/**
+ * struct SortKey - Precomputed sort keys of an Email
+ *
+ * Index 0 is the key of $sort, index 1 the key of $sort_aux.
+ */
+struct SortKey
+{
+  struct Email *email; ///< Email
+  int index;           ///< Position of the Email in the mailbox, see Email.index
+  const char *str[2];  ///< Case-folded name or subject, NULL if none
+  long long num[2];    ///< Date, size or score
+};
+
+/**
+ * sort_has_key - Can a sort method use precomputed keys?
+ * @param method Sort type, see #SortType
+ * @retval true Method can be used by sort_by_keys()
+ */
+static bool sort_has_key(short method)
+{
+  switch (method & SORT_MASK)
+  {
+    case SORT_DATE:
+    case SORT_FROM:
+    case SORT_RECEIVED:
+    case SORT_SCORE:
+    case SORT_SIZE:
+    case SORT_SUBJECT:
+    case SORT_TO:
+      return true;
+    case SORT_ORDER:
+      return mutt_get_sort_func(SORT_ORDER) == compare_order;
+    default:
+      return false;
+  }
+}
+
+/**
+ * sort_key_str - Get the string an Email is sorted by
+ * @param e      Email
+ * @param method Sort type, see #SortType
+ * @retval ptr String, NULL if the method doesn't sort by a string
+ */
+static const char *sort_key_str(const struct Email *e, short method)
+{
+  switch (method & SORT_MASK)
+  {
+    case SORT_FROM:
+      return mutt_get_name(TAILQ_FIRST(&e->env->from));
+    case SORT_SUBJECT:
+      return e->env->real_subj;
+    case SORT_TO:
+      return mutt_get_name(TAILQ_FIRST(&e->env->to));
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * sort_key_num - Get the number an Email is sorted by
+ * @param e      Email
+ * @param method Sort type, see #SortType
+ * @retval num Number, the sent date if the method doesn't sort by a number
+ */
+static long long sort_key_num(const struct Email *e, short method)
+{
+  switch (method & SORT_MASK)
+  {
+    case SORT_RECEIVED:
+      return e->received;
+    case SORT_SCORE:
+      return e->score;
+    case SORT_SIZE:
+      return e->content->length;
+    default:
+      return e->date_sent;
+  }
+}
+
+/**
+ * sort_key_fold - Find the case-folded copy of a sort string
+ * @param strs   Hash Table of case-folded strings
+ * @param buf    Buffer for the work
+ * @param src    String to fold
+ * @param method Sort type, see #SortType
+ * @retval ptr Case-folded string, owned by the Hash Table
+ *
+ * Names are compared by their first 127 characters, like compare_from().
+ * Equal strings share one copy, so they can be compared by their pointers.
+ */
+static char *sort_key_fold(struct Hash *strs, struct Buffer *buf, const char *src, short method)
+{
+  size_t len = mutt_str_strlen(src);
+  if (((method & SORT_MASK) != SORT_SUBJECT) && (len > 127))
+    len = 127;
+
+  mutt_buffer_strcpy_n(buf, src, len);
+  for (char *p = buf->data; *p; p++)
+    *p = tolower((unsigned char) *p);
+
+  char *str = mutt_hash_find(strs, mutt_b2s(buf));
+  if (!str)
+  {
+    str = mutt_str_strdup(mutt_b2s(buf));
+    mutt_hash_insert(strs, str, str);
+  }
+  return str;
+}
+
+/**
+ * sort_key_compare - Compare two Emails using their sort keys
+ * @param a     First key
+ * @param b     Second key
+ * @param level 0 for $sort, 1 for $sort_aux
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ *
+ * This gives the same order as the compare_*() functions, including the
+ * fallback to $sort_aux and to the mailbox order.
+ */
+static int sort_key_compare(const struct SortKey *a, const struct SortKey *b, int level)
+{
+  const short method = level ? C_SortAux : C_Sort;
+  const char *sa = a->str[level];
+  const char *sb = b->str[level];
+  int rc = 0;
+
+  switch (method & SORT_MASK)
+  {
+    case SORT_ORDER:
+      return SORT_KEY_CODE(method, a->index - b->index);
+
+    case SORT_SUBJECT:
+      if (!sa && !sb)
+      {
+        /* compare_subject() falls back to compare_date_sent(), whose result
+         * it reverses a second time */
+        rc = (a->num[level] > b->num[level]) - (a->num[level] < b->num[level]);
+        if ((rc == 0) && (level == 0))
+          rc = sort_key_compare(a, b, 1);
+        if (rc == 0)
+          rc = a->index - b->index;
+        return rc;
+      }
+      /* fallthrough */
+
+    case SORT_FROM:
+    case SORT_TO:
+      if (!sa)
+        rc = -1;
+      else if (!sb)
+        rc = 1;
+      else if (sa != sb)
+        rc = strcmp(sa, sb);
+      break;
+
+    case SORT_SCORE:
+      rc = (b->num[level] > a->num[level]) - (b->num[level] < a->num[level]);
+      break;
+
+    default:
+      rc = (a->num[level] > b->num[level]) - (a->num[level] < b->num[level]);
+      break;
+  }
+
+  if ((rc == 0) && (level == 0))
+    rc = sort_key_compare(a, b, 1);
+  if (rc == 0)
+    rc = a->index - b->index;
+
+  return SORT_KEY_CODE(method, rc);
+}
+
+/**
+ * sort_key_merge - Merge sort an array of sort keys
+ * @param keys Keys to sort
+ * @param tmp  Scratch space, for half the keys
+ * @param num  Number of keys
+ */
+static void sort_key_merge(struct SortKey *keys, struct SortKey *tmp, size_t num)
+{
+  if (num < 16)
+  {
+    for (size_t i = 1; i < num; i++)
+    {
+      struct SortKey key = keys[i];
+      size_t j = i;
+      for (; (j > 0) && (sort_key_compare(&keys[j - 1], &key, 0) > 0); j--)
+        keys[j] = keys[j - 1];
+      keys[j] = key;
+    }
+    return;
+  }
+
+  const size_t half = num / 2;
+  sort_key_merge(keys, tmp, half);
+  sort_key_merge(keys + half, tmp, num - half);
+
+  /* already in order */
+  if (sort_key_compare(&keys[half - 1], &keys[half], 0) <= 0)
+    return;
+
+  memcpy(tmp, keys, half * sizeof(struct SortKey));
+  size_t i = 0, j = half, k = 0;
+  while ((i < half) && (j < num))
+  {
+    if (sort_key_compare(&keys[j], &tmp[i], 0) < 0)
+      keys[k++] = keys[j++];
+    else
+      keys[k++] = tmp[i++];
+  }
+  while (i < half)
+    keys[k++] = tmp[i++];
+}
+
+/**
+ * sort_by_keys - Sort the emails of a Mailbox using precomputed keys
+ * @param m Mailbox
+ *
+ * The names and subjects that compare_from(), compare_to() and
+ * compare_subject() look up on every comparison are case-folded just once.
+ * The sort itself is a stable merge sort.
+ */
+static void sort_by_keys(struct Mailbox *m)
+{
+  const short methods[2] = { C_Sort, C_SortAux };
+  const size_t num = m->msg_count;
+  struct SortKey *keys = mutt_mem_calloc(num, sizeof(struct SortKey));
+  struct Hash *strs = mutt_hash_new(num, MUTT_HASH_NO_FLAGS);
+  struct Buffer *buf = mutt_buffer_pool_get();
+
+  for (size_t i = 0; i < num; i++)
+  {
+    struct Email *e = m->emails[i];
+    keys[i].email = e;
+    keys[i].index = e->index;
+    for (int l = 0; l < 2; l++)
+    {
+      keys[i].num[l] = sort_key_num(e, methods[l]);
+      const char *str = sort_key_str(e, methods[l]);
+      if (str)
+        keys[i].str[l] = sort_key_fold(strs, buf, str, methods[l]);
+    }
+  }
+
+  struct SortKey *tmp = mutt_mem_malloc(((num / 2) + 1) * sizeof(struct SortKey));
+  sort_key_merge(keys, tmp, num);
+  FREE(&tmp);
+
+  for (size_t i = 0; i < num; i++)
+    m->emails[i] = keys[i].email;
+
+  struct HashWalkState state = { 0 };
+  struct HashElem *he = NULL;
+  while ((he = mutt_hash_walk(strs, &state)))
+    FREE(&he->data);
+
+  mutt_hash_free(&strs);
+  mutt_buffer_pool_release(&buf);
+  FREE(&keys);
+}
+
 /**
  * mutt_sort_headers - Sort emails by their headers
  * @param ctx  Mailbox
@@ -429,6 +695,10 @@ void mutt_sort_headers(struct Context *ctx, bool init)
     mutt_error(_("Could not find sorting function [report this bug]"));
     return;
   }
+  else if (sort_has_key(C_Sort) && sort_has_key(C_SortAux))
+  {
+    sort_by_keys(m);
+  }
   else
   {
     qsort((void *) m->emails, m->msg_count, sizeof(struct Email *), sortfunc);
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * Test code for body_filter_free()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include "mutt/lib.h"
+#include "email/lib.h"
+
+void test_body_filter_free(void)
+{
+  // void body_filter_free(struct BodyFilter **ptr);
+
+  {
+    body_filter_free(NULL);
+    TEST_CHECK_(1, "body_filter_free(NULL)");
+  }
+
+  {
+    struct BodyFilter *bf = NULL;
+    body_filter_free(&bf);
+    TEST_CHECK_(1, "body_filter_free(&bf)");
+  }
+
+  {
+    struct BodyFilter *bf = body_filter_new("hello", 5);
+    body_filter_free(&bf);
+    TEST_CHECK(bf == NULL);
+  }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * Test code for body_filter_may_contain()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include "mutt/lib.h"
+#include "email/lib.h"
+
+static const char *text = "From the quick brown fox\n"
+                          "jumps over the LAZY dog.\n"
+                          "Caf\xc3\xa9 au lait\n"
+                          "x\n";
+
+void test_body_filter_may_contain(void)
+{
+  // bool body_filter_may_contain(const struct BodyFilter *bf, const char *str, size_t len);
+
+  struct BodyFilter *bf = body_filter_new(text, strlen(text));
+
+  {
+    TEST_CHECK(body_filter_may_contain(NULL, "fox", 3));
+    TEST_CHECK(body_filter_may_contain(bf, NULL, 0));
+  }
+
+  {
+    // Strings shorter than a trigram can't be ruled out
+    TEST_CHECK(body_filter_may_contain(bf, "", 0));
+    TEST_CHECK(body_filter_may_contain(bf, "q", 1));
+    TEST_CHECK(body_filter_may_contain(bf, "zz", 2));
+  }
+
+  {
+    // Every part of every line is found
+    const char *bol = text;
+    while (*bol)
+    {
+      const char *eol = strchr(bol, '\n');
+      for (const char *p = bol; p < eol; p++)
+      {
+        for (size_t len = 3; p + len <= eol; len++)
+        {
+          if (!TEST_CHECK(body_filter_may_contain(bf, p, len)))
+            TEST_MSG("Missing: %.*s", (int) len, p);
+        }
+      }
+      bol = eol + 1;
+    }
+  }
+
+  {
+    // ASCII case is ignored
+    static const char *hits[] = { "QUICK BROWN", "lazy dog", "Jumps Over", "CAF\xc3\xa9" };
+    for (size_t i = 0; i < mutt_array_size(hits); i++)
+    {
+      TEST_CASE(hits[i]);
+      TEST_CHECK(body_filter_may_contain(bf, hits[i], strlen(hits[i])));
+    }
+  }
+
+  {
+    static const char *misses[] = {
+      "zebra",               // not in the text
+      "fox jumps",           // spans a newline
+      "brown  fox",          // extra space
+      "\xc3\xa9t\xc3\xa9",   // not in the text
+      "lait x",              // spans a newline
+    };
+    for (size_t i = 0; i < mutt_array_size(misses); i++)
+    {
+      TEST_CASE(misses[i]);
+      TEST_CHECK(!body_filter_may_contain(bf, misses[i], strlen(misses[i])));
+    }
+  }
+
+  body_filter_free(&bf);
+
+  {
+    // A large text, using the biggest filter
+    struct Buffer *buf = mutt_buffer_pool_get();
+    for (int i = 0; i < 5000; i++)
+      mutt_buffer_add_printf(buf, "line %d of the message\n", i);
+
+    bf = body_filter_new(mutt_b2s(buf), mutt_buffer_len(buf));
+    TEST_CHECK(body_filter_may_contain(bf, "line 4321 of", 12));
+    TEST_CHECK(body_filter_may_contain(bf, "MESSAGE", 7));
+    TEST_CHECK(!body_filter_may_contain(bf, "needle", 6));
+    body_filter_free(&bf);
+    mutt_buffer_pool_release(&buf);
+  }
+}
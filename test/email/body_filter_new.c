@@ -0,0 +1,72 @@
+/**
+ * @file
+ * Test code for body_filter_new()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include "mutt/lib.h"
+#include "email/lib.h"
+
+void test_body_filter_new(void)
+{
+  // struct BodyFilter *body_filter_new(const char *text, size_t len);
+
+  {
+    struct BodyFilter *bf = body_filter_new(NULL, 0);
+    TEST_CHECK(bf != NULL);
+    TEST_CHECK(bf->size == 32);
+    body_filter_free(&bf);
+  }
+
+  {
+    // Short lines have no trigrams
+    struct BodyFilter *bf = body_filter_new("ab\ncd\n", 6);
+    if (TEST_CHECK(bf != NULL))
+    {
+      bool empty = true;
+      for (unsigned int i = 0; i < bf->size; i++)
+        if (bf->bits[i] != 0)
+          empty = false;
+      TEST_CHECK(empty);
+    }
+    body_filter_free(&bf);
+  }
+
+  {
+    // The filter grows with the text, up to a limit
+    static const size_t lens[] = { 100, 1000, 10000, 100000, 1000000 };
+    static const unsigned int sizes[] = { 32, 128, 2048, 4096, 4096 };
+    char *text = mutt_mem_malloc(1000000);
+    for (size_t i = 0; i < 1000000; i++)
+      text[i] = 'a' + (i % 26);
+
+    for (size_t i = 0; i < mutt_array_size(lens); i++)
+    {
+      struct BodyFilter *bf = body_filter_new(text, lens[i]);
+      TEST_CASE_("%zu", lens[i]);
+      if (!TEST_CHECK(bf->size == sizes[i]))
+        TEST_MSG("Expected %u, got %u", sizes[i], bf->size);
+      body_filter_free(&bf);
+    }
+    FREE(&text);
+  }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file
+ * Dummy code for working around build problems
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "core/lib.h"
+
+struct AddressList;
+struct Body;
+struct Buffer;
+struct Email;
+struct EnterState;
+struct Pager;
+
+const char *GitVer = "";
+short AbortKey = 7;
+
+struct AddressList *mutt_alias_lookup(const char *s)
+{
+  return NULL;
+}
+
+void mutt_default_save(char *path, size_t pathlen, struct Email *e)
+{
+}
+
+uint16_t mutt_is_application_pgp(struct Body *m)
+{
+  return 0;
+}
+
+uint16_t mutt_is_application_smime(struct Body *m)
+{
+  return 0;
+}
+
+void mutt_buffer_select_file(struct Buffer *f, uint8_t flags, char ***files, int *numfiles)
+{
+}
+
+int mutt_enter_string_full(char *buf, size_t buflen, int col, uint16_t flags, bool multiple,
+                           char ***files, int *numfiles, struct EnterState *state)
+{
+  return -1;
+}
+
+void mutt_enter_state_free(struct EnterState **ptr)
+{
+}
+
+struct EnterState *mutt_enter_state_new(void)
+{
+  return NULL;
+}
+
+void mutt_menu_current_redraw(void)
+{
+}
+
+int mutt_monitor_poll(void)
+{
+  return -1;
+}
+
+int mutt_pager(const char *banner, const char *fname, uint16_t flags, struct Pager *extra)
+{
+  return -1;
+}
+
+void mutt_resize_screen(void)
+{
+}
+
+int mutt_system(const char *cmd)
+{
+  return -1;
+}
+
+int mx_access(const char *path, int flags)
+{
+  return -1;
+}
+
+enum MailboxType mx_path_probe(const char *path)
+{
+  return MUTT_UNKNOWN;
+}
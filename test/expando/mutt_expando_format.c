@@ -0,0 +1,252 @@
+/**
+ * @file
+ * Test code for mutt_expando_format()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "format_flags.h"
+#include "muttlib.h"
+
+/* Deeper than the cache of parsed format strings */
+#define NEST_DEPTH 40
+
+struct ExpandoTest
+{
+  const char *format;
+  int cols;
+  const char *expected;
+};
+
+static int NestLevel = 0;
+
+/**
+ * test_format_str - Expand the test expandos - Implements ::format_t
+ *
+ * | Expando | Description
+ * |:--------|:-----------
+ * | \%a     | "apple"
+ * | \%e     | Empty string
+ * | \%n     | "42"
+ * | \%r     | Nest another format string, NEST_DEPTH times
+ */
+static const char *test_format_str(char *buf, size_t buflen, size_t col, int cols,
+                                   char op, const char *src, const char *prec,
+                                   const char *if_str, const char *else_str,
+                                   unsigned long data, MuttFormatFlags flags)
+{
+  char fmt[128];
+  const char *value = NULL;
+
+  switch (op)
+  {
+    case 'a':
+      value = "apple";
+      break;
+    case 'e':
+      value = "";
+      break;
+    case 'n':
+      value = "42";
+      break;
+    case 'r':
+      if (NestLevel < NEST_DEPTH)
+      {
+        NestLevel++;
+        snprintf(fmt, sizeof(fmt), "(%d %%r %d)", NestLevel, NestLevel);
+        mutt_expando_format(buf, buflen, col, cols, fmt, test_format_str, data,
+                            MUTT_FORMAT_NO_FLAGS);
+        return src;
+      }
+      value = ".";
+      break;
+    default:
+      value = "?";
+      break;
+  }
+
+  if (flags & MUTT_FORMAT_OPTIONAL)
+  {
+    mutt_expando_format(buf, buflen, col, cols, *value ? if_str : else_str,
+                        test_format_str, data, MUTT_FORMAT_NO_FLAGS);
+  }
+  else
+  {
+    snprintf(fmt, sizeof(fmt), "%%%ss", prec);
+    snprintf(buf, buflen, fmt, value);
+  }
+
+  return src;
+}
+
+static void check_expando(const char *format, int cols, const char *expected)
+{
+  char buf[1024];
+  mutt_expando_format(buf, sizeof(buf), 0, cols, format, test_format_str, 0,
+                      MUTT_FORMAT_NO_FLAGS);
+  if (!TEST_CHECK(strcmp(buf, expected) == 0))
+  {
+    TEST_MSG("Format: %s", format);
+    TEST_MSG("Expected: %s", expected);
+    TEST_MSG("Actual: %s", buf);
+  }
+}
+
+void test_mutt_expando_format(void)
+{
+  // void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const char *src, format_t *callback, unsigned long data, MuttFormatFlags flags);
+
+  // clang-format off
+  static const struct ExpandoTest tests[] = {
+    { "",                           80, ""                     },
+    { "hello",                      80, "hello"                },
+    { "%a-%n",                      80, "apple-42"             },
+    { "%5n|%-6a|%.3a",              80, "   42|apple |app"     },
+    { "100%% \\t\\\\",              80, "100% \t\\"            },
+    // Conditionals
+    { "%?a?yes&no?",                80, "yes"                  },
+    { "%?e?yes&no?",                80, "no"                   },
+    { "%?e?yes?",                   80, ""                     },
+    { "[%?a?%n&none?]",             80, "[42]"                 },
+    { "%?a?<%n>&-?",                80, "<42>"                 },
+    { "%?e?-&<%a>?",                80, "<apple>"              },
+    { "%<a?yes&no>",                80, "yes"                  },
+    { "%<e?yes&no>",                80, "no"                   },
+    { "%<a?[%<e?x&%n>]&no>",        80, "[42]"                 },
+    { "%<e?x&%<a?[%a]&y>>",         80, "[apple]"              },
+    { "%<a?%<n?%<e?x&deep>&y>&z>!", 80, "deep!"                },
+    // Padding
+    { "%a%>.%n",                    20, "apple.............42" },
+    { "%a%*.%n",                    20, "apple.............42" },
+    { "%a%|-",                      20, "apple---------------" },
+    { "%a%a%>.%n",                  10, "appleapple"           },
+    { "%a%a%*.%n",                  10, "appleapp42"           },
+    { "%a%a%|-",                    10, "appleapple"           },
+    { "%<a?%a%>.%n&x>",             20, "apple.............42" },
+    { "%a%>.%<e?x&%n>",             20, "apple.............42" },
+  };
+  // clang-format on
+
+  for (size_t i = 0; i < mutt_array_size(tests); i++)
+  {
+    TEST_CASE(tests[i].format);
+    check_expando(tests[i].format, tests[i].cols, tests[i].expected);
+    /* The second time, the parsed form is reused */
+    check_expando(tests[i].format, tests[i].cols, tests[i].expected);
+  }
+
+  {
+    // Starting column
+    char buf[64];
+    mutt_expando_format(buf, sizeof(buf), 5, 20, "%a%|-", test_format_str, 0,
+                        MUTT_FORMAT_NO_FLAGS);
+    TEST_CHECK(strcmp(buf, "apple----------") == 0);
+  }
+
+  {
+    // Format strings longer than 256 bytes
+    char format[1024] = { 0 };
+    char expected[1024] = { 0 };
+    for (int i = 0; i < 100; i++)
+    {
+      mutt_str_strcat(format, sizeof(format), "%a ");
+      mutt_str_strcat(expected, sizeof(expected), "apple ");
+    }
+    TEST_CASE("long expandos");
+    check_expando(format, 80, expected);
+    check_expando(format, 80, expected);
+
+    memset(format, 'x', 300);
+    strcpy(format + 300, "%?a?%n&no?");
+    memset(expected, 'x', 300);
+    strcpy(expected + 300, "42");
+    TEST_CASE("long text");
+    check_expando(format, 80, expected);
+
+    memset(format, 'x', 300);
+    strcpy(format + 300, "%<a?%>-%n&no>");
+    memset(expected + 300, '-', 18);
+    strcpy(expected + 318, "42");
+    TEST_CASE("long padding");
+    check_expando(format, 320, expected);
+  }
+
+  {
+    // Truncated to the buffer
+    char format[1024] = { 0 };
+    for (int i = 0; i < 100; i++)
+      mutt_str_strcat(format, sizeof(format), "%a ");
+
+    char buf[16];
+    mutt_expando_format(buf, sizeof(buf), 0, 80, format, test_format_str, 0,
+                        MUTT_FORMAT_NO_FLAGS);
+    TEST_CHECK(strcmp(buf, "apple apple app") == 0);
+    TEST_MSG("Actual: %s", buf);
+  }
+
+  {
+    // Nested deeper than the cache: programs in use mustn't be evicted
+    char expected[1024] = { 0 };
+    char num[16];
+    for (int i = 1; i <= NEST_DEPTH; i++)
+    {
+      snprintf(num, sizeof(num), "(%d ", i);
+      mutt_str_strcat(expected, sizeof(expected), num);
+    }
+    mutt_str_strcat(expected, sizeof(expected), ".");
+    for (int i = NEST_DEPTH; i > 0; i--)
+    {
+      snprintf(num, sizeof(num), " %d)", i);
+      mutt_str_strcat(expected, sizeof(expected), num);
+    }
+
+    char wrapped[1024];
+    snprintf(wrapped, sizeof(wrapped), "<%s>", expected);
+
+    TEST_CASE("nested");
+    NestLevel = 0;
+    check_expando("<%r>", 80, wrapped);
+    NestLevel = 0;
+    check_expando("%r", 80, expected);
+
+    /* Evict everything, then use the strings again */
+    char format[32];
+    char result[32];
+    for (int i = 0; i < (2 * NEST_DEPTH); i++)
+    {
+      snprintf(format, sizeof(format), "%%a %d", i);
+      snprintf(result, sizeof(result), "apple %d", i);
+      check_expando(format, 80, result);
+    }
+    NestLevel = 0;
+    check_expando("%r", 80, expected);
+    check_expando("%?a?<%n>&-?", 80, "<42>");
+  }
+
+  {
+    mutt_expando_cleanup();
+    check_expando("%a-%n", 80, "apple-42");
+    mutt_expando_cleanup();
+  }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file
+ * Test code for mutt_hcache_begin()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
+
+#ifdef USE_HCACHE
+static struct Email *test_email(const char *subject)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  e->env->subject = mutt_str_strdup(subject);
+  e->content = mutt_body_new();
+  return e;
+}
+
+static bool test_cached(header_cache_t *hc, const char *key, const char *subject)
+{
+  struct Email *e = mutt_hcache_fetch_email(hc, key, mutt_str_strlen(key), NULL);
+  if (!e)
+    return false;
+
+  bool rc = (mutt_str_strcmp(e->env->subject, subject) == 0);
+  email_free(&e);
+  return rc;
+}
+#endif
+
+void test_mutt_hcache_begin(void)
+{
+  // int mutt_hcache_begin(header_cache_t *hc);
+
+#ifdef USE_HCACHE
+  {
+    TEST_CHECK(mutt_hcache_begin(NULL) != 0);
+    TEST_CHECK(mutt_hcache_commit(NULL) != 0);
+  }
+
+  char dir[] = "/tmp/neomutt-hcache-XXXXXX";
+  if (!TEST_CHECK(mkdtemp(dir) != NULL))
+    return;
+
+  char path[256];
+  snprintf(path, sizeof(path), "%s/hcache", dir);
+
+  header_cache_t *hc = mutt_hcache_open(path, "folder", NULL);
+  if (!TEST_CHECK(hc != NULL))
+    return;
+
+  {
+    // A commit without a begin
+    TEST_CHECK(mutt_hcache_commit(hc) != 0);
+    TEST_CHECK(hc->batch == 0);
+  }
+
+  {
+    // A batch stored inside a batch, as IMAP does while a search holds one open
+    struct Email *emails[2] = { test_email("apple"), test_email("banana") };
+    const char *keys[2] = { "1", "2" };
+
+    TEST_CHECK(mutt_hcache_begin(hc) == 0);
+    TEST_CHECK(mutt_hcache_store(hc, "0", 1, emails[0], 0) == 0);
+    TEST_CHECK(mutt_hcache_store_n(hc, keys, NULL, emails, 2, 0) == 0);
+    TEST_CHECK(hc->batch == 1);
+
+    /* The inner commit doesn't end the batch, which can carry on */
+    TEST_CHECK(mutt_hcache_store(hc, "3", 1, emails[1], 0) == 0);
+    TEST_CHECK(mutt_hcache_commit(hc) == 0);
+    TEST_CHECK(hc->batch == 0);
+
+    TEST_CHECK(test_cached(hc, "0", "apple"));
+    TEST_CHECK(test_cached(hc, "1", "apple"));
+    TEST_CHECK(test_cached(hc, "2", "banana"));
+    TEST_CHECK(test_cached(hc, "3", "banana"));
+
+    email_free(&emails[0]);
+    email_free(&emails[1]);
+  }
+
+  {
+    // Deeper nesting
+    struct Email *e = test_email("cherry");
+
+    for (int i = 0; i < 3; i++)
+      TEST_CHECK(mutt_hcache_begin(hc) == 0);
+    TEST_CHECK(hc->batch == 3);
+    TEST_CHECK(mutt_hcache_store(hc, "4", 1, e, 0) == 0);
+    for (int i = 0; i < 3; i++)
+      TEST_CHECK(mutt_hcache_commit(hc) == 0);
+    TEST_CHECK(hc->batch == 0);
+    TEST_CHECK(test_cached(hc, "4", "cherry"));
+
+    email_free(&e);
+  }
+
+  mutt_hcache_close(hc);
+
+  TEST_CHECK(mutt_file_rmtree(dir) == 0);
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * Dummy code for working around build problems
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+struct BodyCache;
+struct Buffer;
+struct ConnAccount;
+struct Connection;
+struct Email;
+struct Mailbox;
+struct Url;
+
+typedef int (*bcache_list_t)(const char *id, struct BodyCache *bcache, void *data);
+typedef int sort_t(const void *a, const void *b);
+
+short C_DebugLevel = 0;
+
+int mutt_account_fromurl(struct ConnAccount *account, const struct Url *url)
+{
+  return -1;
+}
+
+void mutt_account_hook(const char *url)
+{
+}
+
+void mutt_account_tourl(struct ConnAccount *account, struct Url *url)
+{
+}
+
+void mutt_bcache_close(struct BodyCache **bcache)
+{
+}
+
+int mutt_bcache_commit(struct BodyCache *bcache, const char *id)
+{
+  return -1;
+}
+
+int mutt_bcache_del(struct BodyCache *bcache, const char *id)
+{
+  return -1;
+}
+
+FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id)
+{
+  return NULL;
+}
+
+int mutt_bcache_list(struct BodyCache *bcache, bcache_list_t want_id, void *data)
+{
+  return -1;
+}
+
+struct BodyCache *mutt_bcache_open(struct ConnAccount *account, const char *mailbox)
+{
+  return NULL;
+}
+
+FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
+{
+  return NULL;
+}
+
+struct Connection *mutt_conn_new(const struct ConnAccount *account)
+{
+  return NULL;
+}
+
+sort_t *mutt_get_sort_func(int method)
+{
+  return NULL;
+}
+
+int mutt_parse_rc_line(char *line, struct Buffer *token, struct Buffer *err)
+{
+  return -1;
+}
+
+int mutt_save_message_ctx(struct Email *e, bool delete_original, bool decode,
+                          bool decrypt, struct Mailbox *m)
+{
+  return -1;
+}
+
+void mutt_zstrm_wrap_conn(struct Connection *conn)
+{
+}
+
+struct Mailbox *mx_mbox_find2(const char *path)
+{
+  return NULL;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file
+ * Test code for imap_search_matched()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "conn/lib.h"
+#include "imap/imap_private.h"
+#include "imap/lib.h"
+#include "imap/message.h"
+#include "pattern.h"
+
+/* A server that gives scripted replies to each command */
+static char ServerReply[1024];   ///< Untagged responses to the next command
+static char ServerOutput[2048]; ///< Responses waiting to be read
+static size_t ServerOutputPos;
+static int ServerSearches;       ///< Number of SEARCH commands received
+
+static int fake_read(struct Connection *conn, char *buf, size_t count)
+{
+  size_t len = MIN(count, strlen(ServerOutput + ServerOutputPos));
+  memcpy(buf, ServerOutput + ServerOutputPos, len);
+  ServerOutputPos += len;
+  return len;
+}
+
+static int fake_write(struct Connection *conn, const char *buf, size_t count)
+{
+  /* Reply with the scripted responses, then complete the tagged command */
+  char tag[16] = { 0 };
+  sscanf(buf, "%15s", tag);
+  if (strstr(buf, " SEARCH "))
+    ServerSearches++;
+
+  snprintf(ServerOutput, sizeof(ServerOutput), "%s%s OK done\r\n", ServerReply, tag);
+  ServerOutputPos = 0;
+  ServerReply[0] = '\0';
+  return count;
+}
+
+static int fake_poll(struct Connection *conn, time_t wait_secs)
+{
+  return 1;
+}
+
+static struct Email *add_email(struct Mailbox *m, unsigned int uid)
+{
+  struct ImapMboxData *mdata = m->mdata;
+  struct ImapEmailData *edata = mutt_mem_calloc(1, sizeof(struct ImapEmailData));
+  edata->uid = uid;
+  edata->msn = m->msg_count + 1;
+
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  e->content = mutt_body_new();
+  e->edata = edata;
+  e->free_edata = imap_edata_free;
+  e->active = true;
+  e->index = m->msg_count;
+
+  m->emails[m->msg_count++] = e;
+  mdata->msn_index[edata->msn - 1] = e;
+  mdata->max_msn = edata->msn;
+  mutt_hash_int_insert(mdata->uid_hash, uid, e);
+  return e;
+}
+
+static int search_matched(struct Mailbox *m, struct PatternList *pat, int msgno)
+{
+  return mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m,
+                           m->emails[msgno], NULL);
+}
+
+void test_imap_search_matched(void)
+{
+  // int imap_search_matched(struct Mailbox *m, const struct Pattern *pat, struct Email *e);
+
+  {
+    TEST_CHECK(imap_search_matched(NULL, NULL, NULL) == -1);
+  }
+
+  struct Connection conn = { 0 };
+  conn.fd = 1;
+  conn.read = fake_read;
+  conn.write = fake_write;
+  conn.poll = fake_poll;
+
+  struct Account a = { 0 };
+  struct ImapAccountData *adata = imap_adata_new(&a);
+  adata->conn = &conn;
+  adata->state = IMAP_SELECTED;
+  a.adata = adata;
+
+  struct Mailbox *m = mailbox_new();
+  m->magic = MUTT_IMAP;
+  m->account = &a;
+  adata->mailbox = m;
+
+  struct ImapMboxData *mdata = mutt_mem_calloc(1, sizeof(struct ImapMboxData));
+  mdata->uid_hash = mutt_hash_int_new(16, MUTT_HASH_NO_FLAGS);
+  mdata->msn_index_size = 8;
+  mdata->msn_index = mutt_mem_calloc(mdata->msn_index_size, sizeof(struct Email *));
+  m->mdata = mdata;
+
+  m->email_max = 8;
+  m->emails = mutt_mem_calloc(m->email_max, sizeof(struct Email *));
+  for (unsigned int uid = 1; uid <= 3; uid++)
+    add_email(m, uid);
+
+  // A limit on the text of the emails, which the server evaluates
+  struct Buffer err = mutt_buffer_make(256);
+  struct PatternList *pat = mutt_pattern_comp("=B apple", MUTT_PC_FULL_MSG, &err);
+  if (!TEST_CHECK(pat != NULL))
+    return;
+
+  {
+    mutt_str_strfcpy(ServerReply, "* SEARCH 1 3\r\n", sizeof(ServerReply));
+    TEST_CHECK(imap_search(m, pat) == 0);
+    TEST_CHECK(ServerSearches == 1);
+
+    TEST_CHECK(search_matched(m, pat, 0) == 1);
+    TEST_CHECK(search_matched(m, pat, 1) == 0);
+    TEST_CHECK(search_matched(m, pat, 2) == 1);
+    TEST_CHECK(ServerSearches == 1);
+  }
+
+  {
+    // New mail wasn't searched, so the server is asked again
+    add_email(m, 4);
+    mutt_str_strfcpy(ServerReply, "* SEARCH 1 3 4\r\n", sizeof(ServerReply));
+    TEST_CHECK(search_matched(m, pat, 3) == 1);
+    TEST_CHECK(ServerSearches == 2);
+    TEST_CHECK(search_matched(m, pat, 1) == 0);
+    TEST_CHECK(ServerSearches == 2);
+  }
+
+  {
+    // The results have been forgotten, e.g. by a search for something else
+    imap_search_reset(mdata);
+    mutt_str_strfcpy(ServerReply, "* SEARCH 1 3 4\r\n", sizeof(ServerReply));
+    TEST_CHECK(search_matched(m, pat, 0) == 1);
+    TEST_CHECK(ServerSearches == 3);
+    TEST_CHECK(search_matched(m, pat, 1) == 0);
+    TEST_CHECK(ServerSearches == 3);
+  }
+
+  {
+    // The server changes the flags of an email, which its search may depend on
+    struct Email *e = m->emails[1];
+    e->limit_checked = true;
+    mutt_str_strfcpy(ServerReply, "* 2 FETCH (UID 2 FLAGS (\\Flagged))\r\n",
+                     sizeof(ServerReply));
+    TEST_CHECK(imap_exec(adata, "NOOP", IMAP_CMD_NO_FLAGS) == IMAP_EXEC_SUCCESS);
+    TEST_CHECK(!e->limit_checked);
+
+    // The limit is applied again, with fresh results
+    mutt_str_strfcpy(ServerReply, "* SEARCH 1 2 3 4\r\n", sizeof(ServerReply));
+    TEST_CHECK(search_matched(m, pat, 1) == 1);
+    TEST_CHECK(ServerSearches == 4);
+    TEST_CHECK(search_matched(m, pat, 0) == 1);
+    TEST_CHECK(ServerSearches == 4);
+  }
+
+  mutt_pattern_free(&pat);
+  mutt_buffer_dealloc(&err);
+  imap_search_reset(mdata);
+  for (int i = 0; i < m->msg_count; i++)
+    email_free(&m->emails[i]);
+  imap_mdata_free((void **) &m->mdata);
+  m->account = NULL;
+  mailbox_free(&m);
+  adata->conn = NULL;
+  imap_adata_free((void **) &a.adata);
+}
@@ -132,6 +132,9 @@
   NEOMUTT_TEST_ITEM(test_mutt_date_normalize_time)                             \
   NEOMUTT_TEST_ITEM(test_mutt_date_parse_date)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_date_parse_imap)                                 \
+  NEOMUTT_TEST_ITEM(test_body_filter_free)                                     \
+  NEOMUTT_TEST_ITEM(test_body_filter_may_contain)                              \
+  NEOMUTT_TEST_ITEM(test_body_filter_new)                                      \
   NEOMUTT_TEST_ITEM(test_email_cmp_strict)                                     \
   NEOMUTT_TEST_ITEM(test_email_free)                                           \
   NEOMUTT_TEST_ITEM(test_email_new)                                            \
@@ -147,6 +150,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_envlist_init)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_envlist_set)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_envlist_unset)                                   \
+  NEOMUTT_TEST_ITEM(test_mutt_expando_format)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_file_check_empty)                                \
   NEOMUTT_TEST_ITEM(test_mutt_file_chmod_add)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_file_chmod_add_stat)                             \
@@ -211,6 +215,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_hash_set_destructor)                             \
   NEOMUTT_TEST_ITEM(test_mutt_hash_typed_insert)                               \
   NEOMUTT_TEST_ITEM(test_mutt_hash_walk)                                       \
+  NEOMUTT_TEST_ITEM(test_mutt_hcache_begin)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_hist_add)                                        \
   NEOMUTT_TEST_ITEM(test_mutt_hist_at_scratch)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_hist_free)                                       \
@@ -225,6 +230,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_idna_local_to_intl)                              \
   NEOMUTT_TEST_ITEM(test_mutt_idna_print_version)                              \
   NEOMUTT_TEST_ITEM(test_mutt_idna_to_ascii_lz)                                \
+  NEOMUTT_TEST_ITEM(test_imap_search_matched)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_list_clear)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_list_compare)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_list_find)                                       \
@@ -251,6 +257,7 @@
   NEOMUTT_TEST_ITEM(test_log_queue_set_max_size)                               \
   NEOMUTT_TEST_ITEM(test_mutt_map_get_name)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_map_get_value)                                   \
+  NEOMUTT_TEST_ITEM(test_mbox_mbox_open)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_mb_charlen)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_mb_filter_unprintable)                           \
   NEOMUTT_TEST_ITEM(test_mutt_mb_get_initials)                                 \
@@ -313,6 +320,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_pattern_comp)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_regex_compile)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_regex_free)                                      \
+  NEOMUTT_TEST_ITEM(test_mutt_regex_literal)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_regex_match)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_regexlist_add)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_regexlist_free)                                  \
@@ -0,0 +1,75 @@
+/**
+ * @file
+ * Dummy code for working around build problems
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "core/lib.h"
+
+struct Context;
+struct Email;
+
+int mutt_copy_message(FILE *fp_out, struct Mailbox *m, struct Email *e,
+                      int cmflags, int chflags, int wraplen)
+{
+  return -1;
+}
+
+void mutt_make_label_hash(struct Mailbox *m)
+{
+}
+
+void mx_alloc_memory_n(struct Mailbox *m, int count)
+{
+  const int new_max = m->msg_count + count;
+  if (new_max <= m->email_max)
+    return;
+
+  m->email_max = new_max;
+  mutt_mem_realloc(&m->emails, sizeof(struct Email *) * m->email_max);
+  mutt_mem_realloc(&m->v2r, sizeof(int) * m->email_max);
+  for (int i = m->msg_count; i < m->email_max; i++)
+  {
+    m->emails[i] = NULL;
+    m->v2r[i] = -1;
+  }
+}
+
+void mx_alloc_memory(struct Mailbox *m)
+{
+  mx_alloc_memory_n(m, m->email_max - m->msg_count + 25);
+}
+
+void mx_fastclose_mailbox(struct Mailbox *m)
+{
+}
+
+int mx_mbox_close(struct Context **ptr)
+{
+  return -1;
+}
+
+struct Context *mx_mbox_open(struct Mailbox *m, int flags)
+{
+  return NULL;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file
+ * Test code for opening an mbox mailbox
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mbox/lib.h"
+
+/* Longer than the buffers the mailbox is read with */
+#define LONG_LINE 20000
+
+static void write_message(FILE *fp, int num, int body_lines, const char *tail)
+{
+  fprintf(fp, "From me@example.com Mon Jan  1 00:00:0%d 2001\n", num);
+  fprintf(fp, "From: me@example.com\n");
+  fprintf(fp, "Subject: message %d\n", num);
+  fprintf(fp, "\n");
+  for (int i = 0; i < body_lines; i++)
+  {
+    for (int j = 0; j < LONG_LINE; j++)
+      fputc('x', fp);
+    fputc('\n', fp);
+  }
+  fputs(tail, fp);
+}
+
+static struct Mailbox *open_mbox(struct Account *a, const char *path)
+{
+  struct Mailbox *m = mailbox_new();
+  mutt_buffer_strcpy(&m->pathbuf, path);
+  m->magic = MUTT_MBOX;
+  m->account = a;
+  m->quiet = true;
+
+  if (!TEST_CHECK(MxMboxOps.mbox_open(m) == 0))
+    TEST_MSG("Couldn't open %s", path);
+  return m;
+}
+
+static void close_mbox(struct Account *a, struct Mailbox **m)
+{
+  MxMboxOps.mbox_close(*m);
+  for (int i = 0; i < (*m)->msg_count; i++)
+    email_free(&(*m)->emails[i]);
+  if (a->free_adata)
+    a->free_adata(&a->adata);
+  mailbox_free(m);
+}
+
+void test_mbox_mbox_open(void)
+{
+  // int mbox_mbox_open(struct Mailbox *m);
+
+  char dir[] = "/tmp/neomutt-mbox-XXXXXX";
+  if (!TEST_CHECK(mkdtemp(dir) != NULL))
+    return;
+
+  char path[256];
+  snprintf(path, sizeof(path), "%s/mbox", dir);
+
+  FILE *fp = fopen(path, "w");
+  if (!TEST_CHECK(fp != NULL))
+    return;
+  write_message(fp, 1, 3, "short\n\n");
+  write_message(fp, 2, 2, "");
+  fclose(fp);
+
+  {
+    // Each long line is counted once
+    struct Account a = { 0 };
+    struct Mailbox *m = open_mbox(&a, path);
+    if (TEST_CHECK(m->msg_count == 2))
+    {
+      TEST_CHECK(m->emails[0]->lines == 4);
+      TEST_MSG("Expected: 4, Actual: %d", m->emails[0]->lines);
+      TEST_CHECK(m->emails[1]->lines == 1);
+      TEST_MSG("Expected: 1, Actual: %d", m->emails[1]->lines);
+    }
+
+    // New mail after blank lines, which extend the last message
+    fp = fopen(path, "a");
+    if (TEST_CHECK(fp != NULL))
+    {
+      fputs("\n", fp);
+      write_message(fp, 3, 1, "\n");
+      fclose(fp);
+    }
+
+    int hint = 0;
+    TEST_CHECK(MxMboxOps.mbox_check(m, &hint) == MUTT_NEW_MAIL);
+    if (TEST_CHECK(m->msg_count == 3))
+    {
+      TEST_CHECK(m->emails[1]->lines == 2);
+      TEST_MSG("Expected: 2, Actual: %d", m->emails[1]->lines);
+      TEST_CHECK(m->emails[2]->lines == 1);
+      TEST_MSG("Expected: 1, Actual: %d", m->emails[2]->lines);
+    }
+
+    close_mbox(&a, &m);
+  }
+
+  {
+    // Reading the mailbox again gives the same counts
+    struct Account a = { 0 };
+    struct Mailbox *m = open_mbox(&a, path);
+    if (TEST_CHECK(m->msg_count == 3))
+    {
+      TEST_CHECK(m->emails[0]->lines == 4);
+      TEST_CHECK(m->emails[1]->lines == 2);
+      TEST_MSG("Expected: 2, Actual: %d", m->emails[1]->lines);
+      TEST_CHECK(m->emails[2]->lines == 1);
+    }
+    close_mbox(&a, &m);
+  }
+
+  TEST_CHECK(mutt_file_rmtree(dir) == 0);
+}
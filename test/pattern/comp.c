@@ -701,7 +701,7 @@ void test_mutt_pattern_comp(void)
                               .min = 0,
                               .max = 0,
                               .p.str = NULL },
-                            /* root->child */
+                            /* root->child->next */
                             { .op = MUTT_PAT_OR,
                               .pat_not = true,
                               .all_addr = false,
@@ -713,7 +713,7 @@ void test_mutt_pattern_comp(void)
                               .min = 0,
                               .max = 0,
                               .p.str = NULL },
-                            /* root->child->child */
+                            /* root->child->next->child */
                             { .op = MUTT_PAT_SUBJECT,
                               .pat_not = false,
                               .all_addr = false,
@@ -725,7 +725,7 @@ void test_mutt_pattern_comp(void)
                               .min = 0,
                               .max = 0,
                               .p.str = "foo" },
-                            /* root->child->child->next */
+                            /* root->child->next->child->next */
                             { .op = MUTT_PAT_SUBJECT,
                               .pat_not = false,
                               .all_addr = false,
@@ -737,7 +737,7 @@ void test_mutt_pattern_comp(void)
                               .min = 0,
                               .max = 0,
                               .p.str = "bar" },
-                            /* root->child->next */
+                            /* root->child, the cheapest goes first */
                             { .op = MUTT_PAT_SUBJECT,
                               .pat_not = false,
                               .all_addr = false,
@@ -756,12 +756,91 @@ void test_mutt_pattern_comp(void)
     struct PatternList child1, child2;
     SLIST_INIT(&child1);
     e[0].child = &child1;
-    SLIST_INSERT_HEAD(e[0].child, &e[1], entries);
+    SLIST_INSERT_HEAD(e[0].child, &e[4], entries);
+    SLIST_INSERT_AFTER(&e[4], &e[1], entries);
     SLIST_INIT(&child2);
     e[1].child = &child2;
     SLIST_INSERT_HEAD(e[1].child, &e[2], entries);
     SLIST_INSERT_AFTER(&e[2], &e[3], entries);
-    SLIST_INSERT_AFTER(&e[1], &e[4], entries);
+
+    if (!TEST_CHECK(!cmp_pattern(pat, &expected)))
+    {
+      char s2[1024];
+      canonical_pattern(s2, &expected, 0);
+      TEST_MSG("Expected:\n%s", s2);
+      canonical_pattern(s2, pat, 0);
+      TEST_MSG("Actual:\n%s", s2);
+    }
+
+    char *msg = "";
+    if (!TEST_CHECK(!strcmp(err.data, msg)))
+    {
+      TEST_MSG("Expected: %s", msg);
+      TEST_MSG("Actual  : %s", err.data);
+    }
+
+    mutt_pattern_free(&pat);
+  }
+
+  {
+    char *s = "=s foo ~F";
+
+    mutt_buffer_reset(&err);
+    struct PatternList *pat = mutt_pattern_comp(s, 0, &err);
+
+    if (!TEST_CHECK(pat != NULL))
+    {
+      TEST_MSG("Expected: pat != NULL");
+      TEST_MSG("Actual  : pat == NULL");
+    }
+
+    struct PatternList expected;
+
+    struct Pattern e[3] = { /* root */
+                            { .op = MUTT_PAT_AND,
+                              .pat_not = false,
+                              .all_addr = false,
+                              .string_match = false,
+                              .group_match = false,
+                              .ign_case = false,
+                              .is_alias = false,
+                              .is_multi = false,
+                              .min = 0,
+                              .max = 0,
+                              .p.str = NULL },
+                            /* root->child, the flag is tested first */
+                            { .op = MUTT_FLAG,
+                              .pat_not = false,
+                              .all_addr = false,
+                              .string_match = false,
+                              .group_match = false,
+                              .ign_case = false,
+                              .is_alias = false,
+                              .is_multi = false,
+                              .min = 0,
+                              .max = 0,
+                              .p.str = NULL },
+                            /* root->child->next */
+                            { .op = MUTT_PAT_SUBJECT,
+                              .pat_not = false,
+                              .all_addr = false,
+                              .string_match = true,
+                              .group_match = false,
+                              .ign_case = true,
+                              .is_alias = false,
+                              .is_multi = false,
+                              .min = 0,
+                              .max = 0,
+                              .p.str = "foo" }
+    };
+
+    SLIST_INIT(&expected);
+    SLIST_INSERT_HEAD(&expected, &e[0], entries);
+    struct PatternList child;
+    SLIST_INIT(&child);
+    e[0].child = &child;
+    SLIST_INSERT_HEAD(e[0].child, &e[1], entries);
+    SLIST_INSERT_AFTER(&e[1], &e[2], entries);
 
     if (!TEST_CHECK(!cmp_pattern(pat, &expected)))
     {
@@ -34,7 +34,6 @@ struct Email;
 struct Envelope;
 struct Mailbox;
 struct Message;
-struct Pattern;
 struct Progress;
 struct State;
 
@@ -49,11 +48,6 @@ int crypt_valid_passphrase(int flags)
   return 0;
 }
 
-int imap_search(struct Mailbox *m, const struct Pattern *pat)
-{
-  return -1;
-}
-
 bool mutt_addr_is_user(struct Address *addr)
 {
   return g_addr_is_user;
@@ -69,6 +63,11 @@ int mutt_body_handler(struct Body *b, struct State *s)
   return -1;
 }
 
+bool mutt_body_is_verbatim(struct Body *b)
+{
+  return false;
+}
+
 void mutt_clear_error(void)
 {
 }
@@ -83,18 +82,6 @@ int mutt_count_body_parts(struct Mailbox *m, struct Email *e)
   return g_body_parts;
 }
 
-int mutt_buffer_get_field_full(const char *field, struct Buffer *buf, int complete,
-                               bool multiple, char ***files, int *numfiles)
-{
-  return -1;
-}
-
-int mutt_get_field_full(const char *field, char *buf, size_t buflen,
-                        int complete, bool multiple, char ***files, int *numfiles)
-{
-  return -1;
-}
-
 bool mutt_is_mail_list(struct Address *addr)
 {
   return g_is_mail_list;
@@ -135,6 +122,21 @@ int mx_msg_padding_size(struct Mailbox *m)
   return 0;
 }
 
+int mx_save_hcache(struct Mailbox *m, struct Email *e)
+{
+  return 0;
+}
+
+int mx_hcache_begin(struct Mailbox *m)
+{
+  return 0;
+}
+
+int mx_hcache_commit(struct Mailbox *m)
+{
+  return 0;
+}
+
 const char *myvar_get(const char *var)
 {
   return g_myvar;
@@ -155,11 +157,6 @@ struct Email *mutt_get_virt_email(struct Mailbox *m, int vnum)
   return m->emails[inum];
 }
 
-void mutt_buffer_mktemp_full(struct Buffer *buf, const char *prefix,
-                             const char *suffix, const char *src, int line)
-{
-}
-
 int mutt_rfc822_write_header(FILE *fp, struct Envelope *env, struct Body *attach,
                              int mode, bool privacy, bool hide_protected_subject)
 {
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * Test code for mutt_regex_literal()
+ *
+ * @authors
+ * Copyright (C) 2019 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+#include "config.h"
+#include <regex.h>
+#include <string.h>
+#include "mutt/lib.h"
+
+struct LiteralTest
+{
+  const char *regex;
+  bool icase;
+  const char *literal;
+};
+
+struct MatchTest
+{
+  const char *regex;
+  bool icase;
+  const char *text;
+};
+
+void test_mutt_regex_literal(void)
+{
+  // char *mutt_regex_literal(const char *pattern, bool icase);
+
+  {
+    TEST_CHECK(!mutt_regex_literal(NULL, false));
+  }
+
+  // clang-format off
+  static const struct LiteralTest tests[] = {
+    { "",                   false, NULL         },
+    { "hello",              false, "hello"      },
+    { "^hello$",            false, "hello"      },
+    // Alternation
+    { "foo|bar",            false, NULL         },
+    { "(a|b)xyz",           false, "xyz"        },
+    // Quantifiers
+    { "*abc",               false, NULL         },
+    { "ab*cdef",            false, "cdef"       },
+    { "ab?cdef",            false, "cdef"       },
+    { "abc+de",             false, "abc"        },
+    { "abx{0,2}cd",         false, "ab"         },
+    { "abx{0,2}cdef",       false, "cdef"       },
+    { "ab{2}c",             false, "ab"         },
+    { "ab{2",               false, NULL         },
+    { "a.b",                false, "a"          },
+    // Groups
+    { "(foo)barbaz",        false, "barbaz"     },
+    { "(foo)*bar",          false, "bar"        },
+    { "(foo",               false, NULL         },
+    { "foo)",               false, NULL         },
+    // Brackets
+    { "[abc]hello",         false, "hello"      },
+    { "[]x]yz",             false, "yz"         },
+    { "[^]x]yz",            false, "yz"         },
+    { "[[:alpha:]]+name",   false, "name"       },
+    { "[abc",               false, NULL         },
+    // Escapes
+    { "www\\.example",      false, "www.example" },
+    { "\\bword\\b",         false, "word"       },
+    { "\\w+abc",            false, "abc"        },
+    { "a\\*b\\+c",          false, "a*b+c"      },
+    { "abc\\",              false, NULL         },
+    // Case folding
+    { "HeLLo",              false, "HeLLo"      },
+    { "HeLLo",              true,  "hello"      },
+    { "[A-Z]+WORLD",        true,  "world"      },
+    // Non-ASCII characters end a run
+    { "ab\xc3\xa9xyz",      false, "xyz"        },
+  };
+  // clang-format on
+
+  for (size_t i = 0; i < mutt_array_size(tests); i++)
+  {
+    const struct LiteralTest *t = &tests[i];
+    TEST_CASE(t->regex);
+    char *lit = mutt_regex_literal(t->regex, t->icase);
+    if (!TEST_CHECK(mutt_str_strcmp(lit, t->literal) == 0))
+    {
+      TEST_MSG("Expected: %s", NONULL(t->literal));
+      TEST_MSG("Actual  : %s", NONULL(lit));
+    }
+    FREE(&lit);
+  }
+
+  // clang-format off
+  static const struct MatchTest matches[] = {
+    { "ab*cdef",                     false, "acdef"                 },
+    { "(foo)*bar",                   false, "bar"                   },
+    { "abx{0,2}cdef",                false, "abxxcdef"              },
+    { "colou?r scheme",              false, "color scheme"          },
+    { "[Ss]ubject: (re|fwd)+ news",  false, "Subject: refwd news"   },
+    { "www\\.example\\.com",         false, "see www.example.com/"  },
+    { "hello world",                 true,  "HELLO World"           },
+    { "[0-9]+ PATCHES",              true,  "42 patches"            },
+  };
+  // clang-format on
+
+  // Every match of the regex contains the literal
+  for (size_t i = 0; i < mutt_array_size(matches); i++)
+  {
+    const struct MatchTest *t = &matches[i];
+    TEST_CASE(t->regex);
+
+    regex_t rx;
+    const int flags = REG_EXTENDED | REG_NOSUB | (t->icase ? REG_ICASE : 0);
+    if (!TEST_CHECK(regcomp(&rx, t->regex, flags) == 0))
+      continue;
+    TEST_CHECK(regexec(&rx, t->text, 0, NULL, 0) == 0);
+    regfree(&rx);
+
+    char *lit = mutt_regex_literal(t->regex, t->icase);
+    char *text = mutt_str_strdup(t->text);
+    if (t->icase)
+      mutt_str_strlower(text);
+    if (TEST_CHECK(lit != NULL) && !TEST_CHECK(strstr(text, lit) != NULL))
+      TEST_MSG("'%s' isn't in '%s'", lit, text);
+    FREE(&text);
+    FREE(&lit);
+  }
+}